@@ -0,0 +1,75 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cassert>
+#include <cmath>
+
+#include "AnimationSystem.h"
+#include "Simd.h"
+
+using namespace std;
+
+uint32_t AnimationSystem::add(float value, float rate, float min, float max) {
+    assert(min < max);
+    auto channel = channelCount();
+    mValues.push_back(value);
+    mRates.push_back(rate);
+    mMins.push_back(min);
+    mRanges.push_back(max - min);
+    mInverseRanges.push_back(1.0f / (max - min));
+    return channel;
+}
+
+void AnimationSystem::update(float delta, float *output) {
+    auto count = channelCount();
+    auto values = mValues.data();
+    uint32_t i = 0;
+
+    // ================================================================================
+    // 1. 네 채널씩 SIMD로 갱신
+    // ================================================================================
+    // value = min + range * fract((value + rate * delta - min) / range)
+    auto deltas = simdSplat(delta);
+    for (; i + 4 <= count; i += 4) {
+        auto mins = simdLoad(&mMins[i]);
+        auto ranges = simdLoad(&mRanges[i]);
+        auto value = simdMulAdd(simdLoad(&mRates[i]), deltas, simdLoad(&values[i]));
+        auto t = simdMul(simdSub(value, mins), simdLoad(&mInverseRanges[i]));
+        value = simdMulAdd(simdSub(t, simdFloor(t)), ranges, mins);
+
+        simdStore(&values[i], value);
+        if (output) {
+            simdStore(&output[i], value);
+        }
+    }
+
+    // ================================================================================
+    // 2. 남은 채널 갱신
+    // ================================================================================
+    for (; i != count; ++i) {
+        auto t = (values[i] + mRates[i] * delta - mMins[i]) * mInverseRanges[i];
+        values[i] = mMins[i] + (t - floor(t)) * mRanges[i];
+        if (output) {
+            output[i] = values[i];
+        }
+    }
+}
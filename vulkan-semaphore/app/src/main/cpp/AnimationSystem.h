@@ -0,0 +1,55 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_ANIMATIONSYSTEM_H
+#define PRACTICE_VULKAN_ANIMATIONSYSTEM_H
+
+#include <cstdint>
+#include <vector>
+
+/*!
+ * Linear channels that wrap within [min, max), evaluated four at a time with SIMD.
+ *
+ * Every channel property lives in its own array, so update() streams through memory once and
+ * needs no gathers. Channels advance by rate * delta, where delta is a real time step in
+ * seconds, so the speed does not depend on the frame rate. When an output pointer is given the
+ * new values are also stored there in channel order, which lets a caller write them straight
+ * into a persistently mapped buffer.
+ */
+class AnimationSystem {
+public:
+    uint32_t add(float value, float rate, float min, float max);
+    uint32_t channelCount() const { return static_cast<uint32_t>(mValues.size()); }
+    float value(uint32_t channel) const { return mValues[channel]; }
+    const float *values() const { return mValues.data(); }
+
+    void update(float delta, float *output = nullptr);
+
+private:
+    std::vector<float> mValues;
+    std::vector<float> mRates;
+    std::vector<float> mMins;
+    std::vector<float> mRanges;
+    std::vector<float> mInverseRanges;
+};
+
+#endif //PRACTICE_VULKAN_ANIMATIONSYSTEM_H
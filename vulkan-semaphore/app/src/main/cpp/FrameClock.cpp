@@ -0,0 +1,85 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cassert>
+
+#include "FrameClock.h"
+
+using namespace std;
+
+FrameClock::FrameClock(Mode mode, Clock::duration fixedStep, Clock::duration maxDelta)
+        : mMode(mode),
+          mFixedStep(fixedStep),
+          mMaxDelta(maxDelta),
+          mLastTick(Clock::now()) {
+    assert(mFixedStep.count() > 0 && mMaxDelta >= mFixedStep);
+}
+
+void FrameClock::tick() {
+    auto now = Clock::now();
+    if (mPaused) {
+        mStepCount = 0;
+        return;
+    }
+
+    // 디버거 정지나 긴 로딩 후에 한 번에 너무 많이 진행하지 않도록 잘라낸다.
+    auto elapsed = min<Clock::duration>(now - mLastTick, mMaxDelta);
+    mLastTick = now;
+
+    if (mMode == kVariableStep) {
+        mStepCount = elapsed.count() > 0 ? 1 : 0;
+        mStepDelta = chrono::duration<float>(elapsed).count();
+        mTime += elapsed;
+        return;
+    }
+
+    // 남은 시간은 다음 프레임으로 넘기고 고정된 크기의 단계만 진행한다.
+    mAccumulator += elapsed;
+    mStepCount = static_cast<uint32_t>(mAccumulator / mFixedStep);
+    mAccumulator -= mFixedStep * mStepCount;
+    mStepDelta = chrono::duration<float>(mFixedStep).count();
+    mTime += mFixedStep * mStepCount;
+}
+
+FrameClock::Clock::duration FrameClock::untilNextStep() const {
+    if (mMode == kVariableStep) {
+        return Clock::duration::zero();
+    }
+
+    auto elapsed = Clock::now() - mLastTick;
+    return max<Clock::duration>(mFixedStep - mAccumulator - elapsed, Clock::duration::zero());
+}
+
+void FrameClock::pause() {
+    mPaused = true;
+    mStepCount = 0;
+}
+
+void FrameClock::resume() {
+    if (!mPaused) {
+        return;
+    }
+
+    mPaused = false;
+    mLastTick = Clock::now();
+}
@@ -0,0 +1,75 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_FRAMECLOCK_H
+#define PRACTICE_VULKAN_FRAMECLOCK_H
+
+#include <chrono>
+#include <cstdint>
+
+/*!
+ * Monotonic clock that turns wall time into simulation steps.
+ *
+ * tick() is called once per frame. In variable step mode each frame gets one step as long as
+ * the time elapsed since the previous tick, clamped to maxDelta. In fixed step mode elapsed
+ * time is accumulated and consumed in whole steps of fixedStep. The simulation time is then
+ * always a multiple of the step, so runs on different devices and present modes pass through
+ * the same states. While paused no time accumulates, and resume() discards the paused interval.
+ */
+class FrameClock {
+public:
+    enum Mode {
+        kVariableStep,
+        kFixedStep
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    FrameClock(Mode mode, Clock::duration fixedStep, Clock::duration maxDelta);
+
+    void tick();
+    void pause();
+    void resume();
+
+    Mode mode() const { return mMode; }
+    bool isPaused() const { return mPaused; }
+    // 이번 프레임에 진행해야 하는 단계 수와 단계마다의 시간(초)
+    uint32_t stepCount() const { return mStepCount; }
+    float stepDelta() const { return mStepDelta; }
+    // 지금까지 진행한 시뮬레이션 시간(초)
+    double time() const { return std::chrono::duration<double>(mTime).count(); }
+    // 다음 단계가 생길 때까지 남은 시간. 가변 단계는 매 tick()마다 진행하므로 0이다.
+    Clock::duration untilNextStep() const;
+
+private:
+    Mode mMode;
+    Clock::duration mFixedStep;
+    Clock::duration mMaxDelta;
+    Clock::time_point mLastTick;
+    Clock::duration mAccumulator{0};
+    Clock::duration mTime{0};
+    uint32_t mStepCount = 0;
+    float mStepDelta = 0.0f;
+    bool mPaused = false;
+};
+
+#endif //PRACTICE_VULKAN_FRAMECLOCK_H
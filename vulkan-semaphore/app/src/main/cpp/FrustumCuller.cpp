@@ -0,0 +1,162 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <random>
+
+#include "FrustumCuller.h"
+#include "Simd.h"
+
+using namespace std;
+
+FrustumCuller::Frustum FrustumCuller::orthographic(float minX, float minY, float maxX, float maxY,
+                                                   float minZ, float maxZ) {
+    return {
+        Plane{{1.0f, 0.0f, 0.0f}, -minX},
+        Plane{{-1.0f, 0.0f, 0.0f}, maxX},
+        Plane{{0.0f, 1.0f, 0.0f}, -minY},
+        Plane{{0.0f, -1.0f, 0.0f}, maxY},
+        Plane{{0.0f, 0.0f, 1.0f}, -minZ},
+        Plane{{0.0f, 0.0f, -1.0f}, maxZ}
+    };
+}
+
+double FrustumCuller::benchmark(JobSystem *jobSystem,
+                                uint32_t objectCount,
+                                uint32_t iterationCount) {
+    // 고정된 시드로 [-1.3, 1.3] 범위에 흩어 놓아서 절반 정도가 컬링되도록 한다.
+    // 반지름 평균이 0.055이므로 보이는 비율은 축마다 1.055 / 1.3, 전체로는 약 53%이다.
+    FrustumCuller culler;
+    mt19937 random(1);
+    uniform_real_distribution<float> position(-1.3f, 1.3f);
+    uniform_real_distribution<float> radius(0.01f, 0.1f);
+    for (uint32_t i = 0; i != objectCount; ++i) {
+        culler.add(position(random), position(random), position(random), radius(random));
+    }
+    culler.setFrustum(orthographic(-1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f));
+
+    // 첫 번째 실행으로 캐시와 워커를 데운 후에 측정한다.
+    culler.cull(jobSystem);
+    auto beginTime = chrono::steady_clock::now();
+    for (uint32_t i = 0; i != iterationCount; ++i) {
+        culler.cull(jobSystem);
+    }
+    auto seconds = chrono::duration<double>(chrono::steady_clock::now() - beginTime).count();
+    return static_cast<double>(objectCount) * iterationCount / seconds;
+}
+
+uint32_t FrustumCuller::add(float x, float y, float z, float radius) {
+    auto object = objectCount();
+    mCenterXs.push_back(x);
+    mCenterYs.push_back(y);
+    mCenterZs.push_back(z);
+    mRadii.push_back(radius);
+    return object;
+}
+
+void FrustumCuller::set(uint32_t object, float x, float y, float z, float radius) {
+    mCenterXs[object] = x;
+    mCenterYs[object] = y;
+    mCenterZs[object] = z;
+    mRadii[object] = radius;
+}
+
+const vector<uint32_t> &FrustumCuller::cull(JobSystem *jobSystem) {
+    // ================================================================================
+    // 1. 청크마다 보이는 오브젝트 찾기
+    // ================================================================================
+    auto chunkCount = (objectCount() + kChunkSize - 1) / kChunkSize;
+    if (mChunkVisibles.size() < chunkCount) {
+        mChunkVisibles.resize(chunkCount);
+        for (auto &visibles: mChunkVisibles) {
+            visibles.reserve(kChunkSize);
+        }
+    }
+
+    if (jobSystem && chunkCount > 1) {
+        jobSystem->parallelFor(chunkCount, [this](uint32_t chunk) { cullChunk(chunk); });
+    } else {
+        for (uint32_t i = 0; i != chunkCount; ++i) {
+            cullChunk(i);
+        }
+    }
+
+    // ================================================================================
+    // 2. 청크 결과를 하나의 목록으로 합치기
+    // ================================================================================
+    mVisibles.clear();
+    for (uint32_t i = 0; i != chunkCount; ++i) {
+        mVisibles.insert(mVisibles.end(), mChunkVisibles[i].begin(), mChunkVisibles[i].end());
+    }
+    return mVisibles;
+}
+
+void FrustumCuller::cullChunk(uint32_t chunk) {
+    auto &visibles = mChunkVisibles[chunk];
+    visibles.clear();
+
+    auto begin = chunk * kChunkSize;
+    auto end = min(begin + kChunkSize, objectCount());
+    auto i = begin;
+
+    // ================================================================================
+    // 1. 네 개씩 SIMD로 검사
+    // ================================================================================
+    // 구의 중심에서 평면까지의 거리가 -radius보다 크면 그 평면 안쪽에 걸쳐 있다.
+    for (; i + 4 <= end; i += 4) {
+        auto x = simdLoad(&mCenterXs[i]);
+        auto y = simdLoad(&mCenterYs[i]);
+        auto z = simdLoad(&mCenterZs[i]);
+        auto negativeRadius = simdSub(simdSplat(0.0f), simdLoad(&mRadii[i]));
+
+        uint32_t mask = 0xf;
+        for (const auto &plane: mFrustum) {
+            auto distance = simdMulAdd(x, simdSplat(plane.normal[0]), simdSplat(plane.distance));
+            distance = simdMulAdd(y, simdSplat(plane.normal[1]), distance);
+            distance = simdMulAdd(z, simdSplat(plane.normal[2]), distance);
+            mask &= simdGreaterMask(distance, negativeRadius);
+            if (!mask) {
+                break;
+            }
+        }
+
+        while (mask) {
+            visibles.push_back(i + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+    }
+
+    // ================================================================================
+    // 2. 남은 오브젝트 검사
+    // ================================================================================
+    for (; i != end; ++i) {
+        auto visible = all_of(mFrustum.begin(), mFrustum.end(), [&](const Plane &plane) {
+            return plane.normal[0] * mCenterXs[i] + plane.normal[1] * mCenterYs[i] +
+                   plane.normal[2] * mCenterZs[i] + plane.distance > -mRadii[i];
+        });
+        if (visible) {
+            visibles.push_back(i);
+        }
+    }
+}
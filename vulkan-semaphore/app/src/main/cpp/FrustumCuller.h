@@ -0,0 +1,77 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_FRUSTUMCULLER_H
+#define PRACTICE_VULKAN_FRUSTUMCULLER_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "JobSystem.h"
+
+/*!
+ * Tests bounding spheres against the six frustum planes, four spheres at a time with SIMD.
+ *
+ * Sphere centers and radii are stored in separate arrays. Objects are split into chunks of
+ * kChunkSize, whose 16 KB of sphere data fits in the L1 cache of current mobile cores. The
+ * chunks are spread over the JobSystem. Each chunk writes its visible indices into its own list,
+ * and cull() concatenates the lists into one compact list in object order.
+ */
+class FrustumCuller {
+public:
+    static constexpr uint32_t kChunkSize = 1024;
+
+    // dot(normal, p) + distance >= 0인 쪽이 안쪽이다.
+    struct Plane {
+        float normal[3];
+        float distance;
+    };
+
+    using Frustum = std::array<Plane, 6>;
+
+    static Frustum orthographic(float minX, float minY, float maxX, float maxY,
+                                float minZ, float maxZ);
+    // 무작위 구 objectCount개를 iterationCount번 컬링해서 초당 처리한 오브젝트 수를 반환한다.
+    static double benchmark(JobSystem *jobSystem, uint32_t objectCount, uint32_t iterationCount);
+
+    uint32_t add(float x, float y, float z, float radius);
+    void set(uint32_t object, float x, float y, float z, float radius);
+    uint32_t objectCount() const { return static_cast<uint32_t>(mRadii.size()); }
+
+    void setFrustum(const Frustum &frustum) { mFrustum = frustum; }
+    // jobSystem이 없으면 호출한 스레드에서만 컬링한다.
+    const std::vector<uint32_t> &cull(JobSystem *jobSystem);
+
+private:
+    void cullChunk(uint32_t chunk);
+
+    std::vector<float> mCenterXs;
+    std::vector<float> mCenterYs;
+    std::vector<float> mCenterZs;
+    std::vector<float> mRadii;
+    Frustum mFrustum{};
+    std::vector<std::vector<uint32_t>> mChunkVisibles;
+    std::vector<uint32_t> mVisibles;
+};
+
+#endif //PRACTICE_VULKAN_FRUSTUMCULLER_H
@@ -0,0 +1,54 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_HASH_H
+#define PRACTICE_VULKAN_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*!
+ * 64-bit FNV-1a for cache keys. Fast and good enough to spread keys over hash maps, but not
+ * collision resistant, so caches still compare the full key on a hit.
+ */
+constexpr uint64_t kHashSeed = 14695981039346656037ull;
+
+inline uint64_t hashCombine(uint64_t seed, const void *data, size_t size) {
+    auto bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i != size; ++i) {
+        seed = (seed ^ bytes[i]) * 1099511628211ull;
+    }
+    return seed;
+}
+
+template<typename T>
+inline uint64_t hashCombine(uint64_t seed, const T &value) {
+    return hashCombine(seed, &value, sizeof(T));
+}
+
+template<typename T>
+inline uint64_t hashCombine(uint64_t seed, const std::vector<T> &values) {
+    return hashCombine(seed, values.data(), values.size() * sizeof(T));
+}
+
+#endif //PRACTICE_VULKAN_HASH_H
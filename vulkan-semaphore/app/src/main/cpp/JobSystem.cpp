@@ -0,0 +1,124 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+
+#include "JobSystem.h"
+
+using namespace std;
+
+JobSystem::JobSystem(uint32_t threadCount) {
+    // 스레드 수를 지정하지 않으면 렌더 스레드를 제외한 나머지 코어를 사용한다.
+    if (!threadCount) {
+        // hardware_concurrency()는 코어 수를 알 수 없으면 0을 반환한다.
+        auto coreCount = thread::hardware_concurrency();
+        threadCount = coreCount > 1 ? coreCount - 1 : 1;
+    }
+
+    for (uint32_t i = 0; i != threadCount; ++i) {
+        mThreads.emplace_back(&JobSystem::run, this);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        lock_guard<mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mJobCondition.notify_all();
+
+    for (auto &thread : mThreads) {
+        thread.join();
+    }
+}
+
+void JobSystem::submit(Job job) {
+    {
+        lock_guard<mutex> lock(mMutex);
+        mJobs.push_back(std::move(job));
+    }
+    mJobCondition.notify_one();
+}
+
+void JobSystem::wait() {
+    unique_lock<mutex> lock(mMutex);
+    mIdleCondition.wait(lock, [this]() { return mJobs.empty() && !mActiveCount; });
+}
+
+void JobSystem::parallelFor(uint32_t taskCount, const function<void(uint32_t)> &task) {
+    if (!taskCount) {
+        return;
+    }
+
+    // 늦게 시작한 워커가 반환 후에 접근할 수 있으므로 상태는 공유 포인터로 넘긴다.
+    auto state = make_shared<ParallelFor>();
+    state->task = task;
+    state->taskCount = taskCount;
+
+    auto helperCount = min(threadCount(), taskCount - 1);
+    for (uint32_t i = 0; i != helperCount; ++i) {
+        submit([state]() { runParallelFor(*state); });
+    }
+    runParallelFor(*state);
+
+    unique_lock<mutex> lock(state->mutex);
+    state->doneCondition.wait(lock, [&]() { return state->doneCount == taskCount; });
+}
+
+void JobSystem::runParallelFor(ParallelFor &parallelFor) {
+    uint32_t task;
+    while ((task = parallelFor.nextTask++) < parallelFor.taskCount) {
+        parallelFor.task(task);
+        if (++parallelFor.doneCount == parallelFor.taskCount) {
+            lock_guard<mutex> lock(parallelFor.mutex);
+            parallelFor.doneCondition.notify_all();
+        }
+    }
+}
+
+void JobSystem::run() {
+    while (true) {
+        Job job;
+        {
+            unique_lock<mutex> lock(mMutex);
+            mJobCondition.wait(lock, [this]() { return mStopping || !mJobs.empty(); });
+            // 종료 요청이 있어도 남아있는 작업은 모두 실행한다.
+            if (mJobs.empty()) {
+                return;
+            }
+
+            job = std::move(mJobs.front());
+            mJobs.pop_front();
+            ++mActiveCount;
+        }
+
+        job();
+
+        {
+            lock_guard<mutex> lock(mMutex);
+            --mActiveCount;
+            if (mJobs.empty() && !mActiveCount) {
+                mIdleCondition.notify_all();
+            }
+        }
+    }
+}
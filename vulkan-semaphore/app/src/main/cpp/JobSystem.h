@@ -0,0 +1,81 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_JOBSYSTEM_H
+#define PRACTICE_VULKAN_JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!
+ * Fixed pool of worker threads that run jobs in submission order.
+ *
+ * The render thread is never one of the workers, so anything submitted here can block on the
+ * driver without stalling a frame. parallelFor() is the exception: the calling thread claims
+ * tasks too, so it finishes even while every worker is busy compiling pipelines.
+ */
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    explicit JobSystem(uint32_t threadCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    void submit(Job job);
+    void wait();
+    // task(0) ... task(taskCount - 1)를 나눠서 실행하고 모두 끝날 때까지 기다린다.
+    void parallelFor(uint32_t taskCount, const std::function<void(uint32_t)> &task);
+    uint32_t threadCount() const { return static_cast<uint32_t>(mThreads.size()); }
+
+private:
+    struct ParallelFor {
+        std::function<void(uint32_t)> task;
+        uint32_t taskCount;
+        std::atomic<uint32_t> nextTask{0};
+        std::atomic<uint32_t> doneCount{0};
+        std::mutex mutex;
+        std::condition_variable doneCondition;
+    };
+
+    static void runParallelFor(ParallelFor &parallelFor);
+    void run();
+
+    std::vector<std::thread> mThreads;
+    std::deque<Job> mJobs;
+    std::mutex mMutex;
+    std::condition_variable mJobCondition;
+    std::condition_variable mIdleCondition;
+    uint32_t mActiveCount = 0;
+    bool mStopping = false;
+};
+
+#endif //PRACTICE_VULKAN_JOBSYSTEM_H
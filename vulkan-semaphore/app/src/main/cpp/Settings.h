@@ -0,0 +1,52 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_SETTINGS_H
+#define PRACTICE_VULKAN_SETTINGS_H
+
+#include <cstdlib>
+#include <string>
+#include <sys/system_properties.h>
+
+/*!
+ * Reads a runtime setting from the Android system properties so that benchmark modes can be
+ * switched without rebuilding, e.g.
+ *
+ *  adb shell setprop debug.practicevulkan.triangles 10000
+ */
+inline std::string getStringSetting(const char *name, const std::string &defaultValue) {
+    char value[PROP_VALUE_MAX];
+    if (__system_property_get(name, value) > 0) {
+        return value;
+    }
+    return defaultValue;
+}
+
+inline int getIntSetting(const char *name, int defaultValue) {
+    char value[PROP_VALUE_MAX];
+    if (__system_property_get(name, value) > 0) {
+        return atoi(value);
+    }
+    return defaultValue;
+}
+
+#endif //PRACTICE_VULKAN_SETTINGS_H
@@ -0,0 +1,220 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_SIMD_H
+#define PRACTICE_VULKAN_SIMD_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#define PRACTICE_VULKAN_SIMD_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define PRACTICE_VULKAN_SIMD_SSE2 1
+#endif
+
+/*!
+ * Four float lanes mapped to NEON on ARM and SSE2 on x86.
+ *
+ * Only the operations the CPU-side systems need are provided. Other targets fall back to a
+ * plain array that the compiler may still auto-vectorize. Loads and stores are unaligned so
+ * std::vector storage and mapped Vulkan memory can be used directly.
+ */
+struct Float4 {
+#if defined(PRACTICE_VULKAN_SIMD_NEON)
+    float32x4_t v;
+#elif defined(PRACTICE_VULKAN_SIMD_SSE2)
+    __m128 v;
+#else
+    float v[4];
+#endif
+};
+
+inline Float4 simdSplat(float value) {
+#if defined(PRACTICE_VULKAN_SIMD_NEON)
+    return {vdupq_n_f32(value)};
+#elif defined(PRACTICE_VULKAN_SIMD_SSE2)
+    return {_mm_set1_ps(value)};
+#else
+    return {{value, value, value, value}};
+#endif
+}
+
+inline Float4 simdLoad(const float *data) {
+#if defined(PRACTICE_VULKAN_SIMD_NEON)
+    return {vld1q_f32(data)};
+#elif defined(PRACTICE_VULKAN_SIMD_SSE2)
+    return {_mm_loadu_ps(data)};
+#else
+    return {{data[0], data[1], data[2], data[3]}};
+#endif
+}
+
+inline void simdStore(float *data, Float4 a) {
+#if defined(PRACTICE_VULKAN_SIMD_NEON)
+    vst1q_f32(data, a.v);
+#elif defined(PRACTICE_VULKAN_SIMD_SSE2)
+    _mm_storeu_ps(data, a.v);
+#else
+    for (int i = 0; i != 4; ++i) {
+        data[i] = a.v[i];
+    }
+#endif
+}
+
+inline Float4 simdAdd(Float4 a, Float4 b) {
+#if defined(PRACTICE_VULKAN_SIMD_NEON)
+    return {vaddq_f32(a.v, b.v)};
+#elif defined(PRACTICE_VULKAN_SIMD_SSE2)
+    return {_mm_add_ps(a.v, b.v)};
+#else
+    return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+#endif
+}
+
+inline Float4 simdSub(Float4 a, Float4 b) {
+#if defined(PRACTICE_VULKAN_SIMD_NEON)
+    return {vsubq_f32(a.v, b.v)};
+#elif defined(PRACTICE_VULKAN_SIMD_SSE2)
+    return {_mm_sub_ps(a.v, b.v)};
+#else
+    return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}};
+#endif
+}
+
+inline Float4 simdMul(Float4 a, Float4 b) {
+#if defined(PRACTICE_VULKAN_SIMD_NEON)
+    return {vmulq_f32(a.v, b.v)};
+#elif defined(PRACTICE_VULKAN_SIMD_SSE2)
+    return {_mm_mul_ps(a.v, b.v)};
+#else
+    return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}};
+#endif
+}
+
+// a * b + c
+inline Float4 simdMulAdd(Float4 a, Float4 b, Float4 c) {
+#if defined(PRACTICE_VULKAN_SIMD_NEON)
+    return {vmlaq_f32(c.v, a.v, b.v)};
+#else
+    return simdAdd(simdMul(a, b), c);
+#endif
+}
+
+// 32비트 정수 범위 안의 값만 지원한다.
+inline Float4 simdFloor(Float4 a) {
+#if defined(PRACTICE_VULKAN_SIMD_NEON) && defined(__aarch64__)
+    return {vrndmq_f32(a.v)};
+#elif defined(PRACTICE_VULKAN_SIMD_NEON)
+    // 0 방향으로 자른 값이 원래 값보다 크면 1을 뺀다.
+    auto truncated = vcvtq_f32_s32(vcvtq_s32_f32(a.v));
+    auto greater = vcgtq_f32(truncated, a.v);
+    return {vsubq_f32(truncated,
+                      vreinterpretq_f32_u32(vandq_u32(greater,
+                                                      vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))))};
+#elif defined(PRACTICE_VULKAN_SIMD_SSE2)
+    auto truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+    auto greater = _mm_cmpgt_ps(truncated, a.v);
+    return {_mm_sub_ps(truncated, _mm_and_ps(greater, _mm_set1_ps(1.0f)))};
+#else
+    return {{std::floor(a.v[0]), std::floor(a.v[1]), std::floor(a.v[2]), std::floor(a.v[3])}};
+#endif
+}
+
+// a > b인 레인의 비트가 켜진 4비트 마스크
+inline uint32_t simdGreaterMask(Float4 a, Float4 b) {
+#if defined(PRACTICE_VULKAN_SIMD_NEON)
+    static const uint32_t kLaneBits[4] = {1, 2, 4, 8};
+    auto bits = vandq_u32(vcgtq_f32(a.v, b.v), vld1q_u32(kLaneBits));
+#if defined(__aarch64__)
+    return vaddvq_u32(bits);
+#else
+    auto pairs = vpadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+    return vget_lane_u32(vpadd_u32(pairs, pairs), 0);
+#endif
+#elif defined(PRACTICE_VULKAN_SIMD_SSE2)
+    return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpgt_ps(a.v, b.v)));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i != 4; ++i) {
+        mask |= (a.v[i] > b.v[i] ? 1u : 0u) << i;
+    }
+    return mask;
+#endif
+}
+
+template<int lane>
+inline Float4 simdBroadcast(Float4 a) {
+#if defined(PRACTICE_VULKAN_SIMD_NEON)
+    return {vdupq_n_f32(vgetq_lane_f32(a.v, lane))};
+#elif defined(PRACTICE_VULKAN_SIMD_SSE2)
+    return {_mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(lane, lane, lane, lane))};
+#else
+    return simdSplat(a.v[lane]);
+#endif
+}
+
+/*!
+ * Column-major 4x4 matrix, one Float4 per column, matching GLSL mat4 memory layout.
+ */
+struct Float4x4 {
+    Float4 columns[4];
+};
+
+inline Float4x4 simdIdentity() {
+    return {{simdLoad(std::array<float, 4>{1.0f, 0.0f, 0.0f, 0.0f}.data()),
+             simdLoad(std::array<float, 4>{0.0f, 1.0f, 0.0f, 0.0f}.data()),
+             simdLoad(std::array<float, 4>{0.0f, 0.0f, 1.0f, 0.0f}.data()),
+             simdLoad(std::array<float, 4>{0.0f, 0.0f, 0.0f, 1.0f}.data())}};
+}
+
+inline Float4x4 simdTranslation(float x, float y, float z) {
+    auto result = simdIdentity();
+    result.columns[3] = simdLoad(std::array<float, 4>{x, y, z, 1.0f}.data());
+    return result;
+}
+
+inline Float4x4 simdScaling(float x, float y, float z) {
+    return {{simdLoad(std::array<float, 4>{x, 0.0f, 0.0f, 0.0f}.data()),
+             simdLoad(std::array<float, 4>{0.0f, y, 0.0f, 0.0f}.data()),
+             simdLoad(std::array<float, 4>{0.0f, 0.0f, z, 0.0f}.data()),
+             simdLoad(std::array<float, 4>{0.0f, 0.0f, 0.0f, 1.0f}.data())}};
+}
+
+// a * b. 결과의 각 열은 a의 열들을 b의 열 성분으로 가중합한 것이다.
+inline Float4x4 simdMul(const Float4x4 &a, const Float4x4 &b) {
+    Float4x4 result;
+    for (int i = 0; i != 4; ++i) {
+        auto column = b.columns[i];
+        auto value = simdMul(a.columns[0], simdBroadcast<0>(column));
+        value = simdMulAdd(a.columns[1], simdBroadcast<1>(column), value);
+        value = simdMulAdd(a.columns[2], simdBroadcast<2>(column), value);
+        value = simdMulAdd(a.columns[3], simdBroadcast<3>(column), value);
+        result.columns[i] = value;
+    }
+    return result;
+}
+
+#endif //PRACTICE_VULKAN_SIMD_H
@@ -0,0 +1,70 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cassert>
+
+#include "TransformHierarchy.h"
+
+using namespace std;
+
+uint32_t TransformHierarchy::add(uint32_t parent, const Float4x4 &local) {
+    auto node = nodeCount();
+    assert(parent == kNoParent || parent < node);
+    mParents.push_back(parent);
+    mLocals.push_back(local);
+    mWorlds.push_back(local);
+    mDirty.push_back(1);
+    mChanged.push_back(0);
+    ++mDirtyCount;
+    return node;
+}
+
+void TransformHierarchy::setLocal(uint32_t node, const Float4x4 &local) {
+    mLocals[node] = local;
+    if (!mDirty[node]) {
+        mDirty[node] = 1;
+        ++mDirtyCount;
+    }
+}
+
+void TransformHierarchy::update() {
+    mUpdatedCount = 0;
+    if (!mDirtyCount) {
+        return;
+    }
+
+    // 부모가 항상 앞에 있으므로 한 번의 순회로 변경이 자식까지 전파된다.
+    auto count = nodeCount();
+    for (uint32_t i = 0; i != count; ++i) {
+        auto parent = mParents[i];
+        auto parentChanged = parent != kNoParent && mChanged[parent];
+        mChanged[i] = mDirty[i] || parentChanged;
+        if (!mChanged[i]) {
+            continue;
+        }
+
+        mWorlds[i] = parent == kNoParent ? mLocals[i] : simdMul(mWorlds[parent], mLocals[i]);
+        mDirty[i] = 0;
+        ++mUpdatedCount;
+    }
+    mDirtyCount = 0;
+}
@@ -0,0 +1,65 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_TRANSFORMHIERARCHY_H
+#define PRACTICE_VULKAN_TRANSFORMHIERARCHY_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Simd.h"
+
+/*!
+ * Node transforms stored in flat arrays, every parent before its children.
+ *
+ * A node can only be added after its parent, so update() computes all world matrices in one
+ * forward pass with SIMD matrix products and no pointer chasing. setLocal() marks a node
+ * dirty. A node is recomputed only when its own local matrix or its parent's world matrix
+ * changed, so unchanged subtrees cost one flag test per node, and update() returns at once
+ * when nothing is dirty.
+ */
+class TransformHierarchy {
+public:
+    static constexpr uint32_t kNoParent = UINT32_MAX;
+
+    uint32_t add(uint32_t parent, const Float4x4 &local);
+    void setLocal(uint32_t node, const Float4x4 &local);
+    void update();
+
+    uint32_t nodeCount() const { return static_cast<uint32_t>(mParents.size()); }
+    const Float4x4 &world(uint32_t node) const { return mWorlds[node]; }
+    // 마지막 update()에서 월드 행렬이 바뀌었는지 반환한다.
+    bool isChanged(uint32_t node) const { return mUpdatedCount && mChanged[node]; }
+    // 마지막 update()에서 다시 계산한 노드 수
+    uint32_t updatedCount() const { return mUpdatedCount; }
+
+private:
+    std::vector<uint32_t> mParents;
+    std::vector<Float4x4> mLocals;
+    std::vector<Float4x4> mWorlds;
+    std::vector<uint8_t> mDirty;
+    std::vector<uint8_t> mChanged;
+    uint32_t mDirtyCount = 0;
+    uint32_t mUpdatedCount = 0;
+};
+
+#endif //PRACTICE_VULKAN_TRANSFORMHIERARCHY_H
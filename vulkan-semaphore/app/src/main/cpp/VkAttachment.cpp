@@ -0,0 +1,173 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cassert>
+
+#include "VkAttachment.h"
+#include "VkUtil.h"
+#include "AndroidOut.h"
+
+using namespace std;
+
+namespace {
+
+VkImageAspectFlags toAspectMask(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_D16_UNORM:
+        case VK_FORMAT_X8_D24_UNORM_PACK32:
+        case VK_FORMAT_D32_SFLOAT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT;
+        case VK_FORMAT_S8_UINT:
+            return VK_IMAGE_ASPECT_STENCIL_BIT;
+        case VK_FORMAT_D16_UNORM_S8_UINT:
+        case VK_FORMAT_D24_UNORM_S8_UINT:
+        case VK_FORMAT_D32_SFLOAT_S8_UINT:
+            return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        default:
+            return VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+}
+
+}
+
+VkAttachment::VkAttachment(VkHostAllocator &hostAllocator,
+                           VkMemoryBudget &memoryBudget,
+                           VkDevice device,
+                           VkFormat format,
+                           VkExtent2D extent,
+                           VkSampleCountFlagBits samples,
+                           VkImageUsageFlags usage,
+                           bool transient)
+        : mHostAllocator(hostAllocator),
+          mMemoryBudget(memoryBudget),
+          mDevice(device),
+          mFormat(format),
+          mAspectMask(toAspectMask(format)) {
+    // ================================================================================
+    // 1. VkImage 생성
+    // ================================================================================
+    if (transient) {
+        usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+    }
+
+    VkImageCreateInfo imageCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .imageType = VK_IMAGE_TYPE_2D,
+        .format = mFormat,
+        .extent = {extent.width, extent.height, 1},
+        .mipLevels = 1,
+        .arrayLayers = 1,
+        .samples = samples,
+        .tiling = VK_IMAGE_TILING_OPTIMAL,
+        .usage = usage,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+    };
+
+    VK_CHECK_ERROR(vkCreateImage(mDevice,
+                                 &imageCreateInfo,
+                                 mHostAllocator.callbacks(VK_OBJECT_TYPE_IMAGE),
+                                 &mImage));
+
+    // ================================================================================
+    // 2. VkDeviceMemory 할당
+    // ================================================================================
+    VkMemoryRequirements memoryRequirements;
+    vkGetImageMemoryRequirements(mDevice, mImage, &memoryRequirements);
+
+    const auto &memoryProperties = mMemoryBudget.memoryProperties();
+    mMemoryTypeIndex = VK_MAX_MEMORY_TYPES;
+    if (transient) {
+        mMemoryTypeIndex = vkFindMemoryTypeIndex(memoryProperties,
+                                                 memoryRequirements.memoryTypeBits,
+                                                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+                                                 VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
+    }
+
+    mLazilyAllocated = mMemoryTypeIndex != VK_MAX_MEMORY_TYPES;
+    if (!mLazilyAllocated) {
+        mMemoryTypeIndex = vkFindMemoryTypeIndex(memoryProperties,
+                                                 memoryRequirements.memoryTypeBits,
+                                                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    }
+    assert(mMemoryTypeIndex != VK_MAX_MEMORY_TYPES);
+
+    VkMemoryAllocateInfo memoryAllocateInfo{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .allocationSize = memoryRequirements.size,
+        .memoryTypeIndex = mMemoryTypeIndex
+    };
+
+    VK_CHECK_ERROR(vkAllocateMemory(mDevice,
+                                    &memoryAllocateInfo,
+                                    mHostAllocator.callbacks(VK_OBJECT_TYPE_DEVICE_MEMORY),
+                                    &mMemory));
+    VK_CHECK_ERROR(vkBindImageMemory(mDevice, mImage, mMemory, 0));
+
+    // 지연 할당된 메모리는 실제로 커밋된 양만 사용량에 반영한다.
+    mMemorySize = memoryAllocateInfo.allocationSize;
+    if (!mLazilyAllocated) {
+        mMemoryBudget.onAllocate(mMemoryTypeIndex, mMemorySize);
+    }
+
+    // ================================================================================
+    // 3. VkImageView 생성
+    // ================================================================================
+    VkImageViewCreateInfo imageViewCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+        .image = mImage,
+        .viewType = VK_IMAGE_VIEW_TYPE_2D,
+        .format = mFormat,
+        .subresourceRange = {
+            .aspectMask = mAspectMask,
+            .baseMipLevel = 0,
+            .levelCount = 1,
+            .baseArrayLayer = 0,
+            .layerCount = 1
+        }
+    };
+
+    VK_CHECK_ERROR(vkCreateImageView(mDevice,
+                                     &imageViewCreateInfo,
+                                     mHostAllocator.callbacks(VK_OBJECT_TYPE_IMAGE_VIEW),
+                                     &mImageView));
+}
+
+VkAttachment::~VkAttachment() {
+    vkDestroyImageView(mDevice, mImageView, mHostAllocator.callbacks(VK_OBJECT_TYPE_IMAGE_VIEW));
+    vkFreeMemory(mDevice, mMemory, mHostAllocator.callbacks(VK_OBJECT_TYPE_DEVICE_MEMORY));
+    if (!mLazilyAllocated) {
+        mMemoryBudget.onFree(mMemoryTypeIndex, mMemorySize);
+    }
+    vkDestroyImage(mDevice, mImage, mHostAllocator.callbacks(VK_OBJECT_TYPE_IMAGE));
+}
+
+VkDeviceSize VkAttachment::committedSize() const {
+    if (!mLazilyAllocated) {
+        return mMemorySize;
+    }
+
+    VkDeviceSize committedSize;
+    vkGetDeviceMemoryCommitment(mDevice, mMemory, &committedSize);
+
+    return committedSize;
+}
@@ -0,0 +1,76 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKATTACHMENT_H
+#define PRACTICE_VULKAN_VKATTACHMENT_H
+
+#include <vulkan/vulkan.h>
+
+#include "VkHostAllocator.h"
+#include "VkMemoryBudget.h"
+
+/*!
+ * Image and view for a depth, MSAA or intermediate attachment.
+ *
+ * Attachments whose contents never leave the render pass are created with
+ * VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT and bound to LAZILY_ALLOCATED memory when the device
+ * offers it. On tile-based GPUs such attachments live entirely in tile memory, so the backing
+ * memory is usually never committed. Otherwise they fall back to regular device local memory.
+ */
+class VkAttachment {
+public:
+    VkAttachment(VkHostAllocator &hostAllocator,
+                 VkMemoryBudget &memoryBudget,
+                 VkDevice device,
+                 VkFormat format,
+                 VkExtent2D extent,
+                 VkSampleCountFlagBits samples,
+                 VkImageUsageFlags usage,
+                 bool transient);
+    ~VkAttachment();
+
+    VkAttachment(const VkAttachment &) = delete;
+    VkAttachment &operator=(const VkAttachment &) = delete;
+
+    VkImage image() const { return mImage; }
+    VkImageView imageView() const { return mImageView; }
+    VkFormat format() const { return mFormat; }
+    VkImageAspectFlags aspectMask() const { return mAspectMask; }
+    bool isLazilyAllocated() const { return mLazilyAllocated; }
+    VkDeviceSize size() const { return mMemorySize; }
+    VkDeviceSize committedSize() const;
+
+private:
+    VkHostAllocator &mHostAllocator;
+    VkMemoryBudget &mMemoryBudget;
+    VkDevice mDevice;
+    VkFormat mFormat;
+    VkImageAspectFlags mAspectMask;
+    VkImage mImage;
+    VkDeviceMemory mMemory;
+    uint32_t mMemoryTypeIndex;
+    VkDeviceSize mMemorySize;
+    bool mLazilyAllocated;
+    VkImageView mImageView;
+};
+
+#endif //PRACTICE_VULKAN_VKATTACHMENT_H
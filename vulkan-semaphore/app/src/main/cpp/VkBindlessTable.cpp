@@ -0,0 +1,128 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cassert>
+
+#include "VkBindlessTable.h"
+#include "VkUtil.h"
+
+using namespace std;
+
+VkBindlessTable::VkBindlessTable(VkHostAllocator &hostAllocator,
+                                 VkDevice device,
+                                 VkObjectCache &objectCache)
+        : mHostAllocator(hostAllocator),
+          mDevice(device) {
+    // ================================================================================
+    // 1. VkDescriptorSetLayout 생성
+    // ================================================================================
+    VkDescriptorBindingFlags descriptorBindingFlags = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                                                      VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+        .bindingCount = 1,
+        .pBindingFlags = &descriptorBindingFlags
+    };
+
+    VkDescriptorSetLayoutBinding descriptorSetLayoutBinding{
+        .binding = 0,
+        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+        .descriptorCount = kMaxTextureCount,
+        .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT
+    };
+
+    VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .pNext = &bindingFlagsCreateInfo,
+        .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+        .bindingCount = 1,
+        .pBindings = &descriptorSetLayoutBinding
+    };
+
+    mDescriptorSetLayout = objectCache.descriptorSetLayout(descriptorSetLayoutCreateInfo);
+
+    // ================================================================================
+    // 2. VkDescriptorPool 생성
+    // ================================================================================
+    VkDescriptorPoolSize poolSize{
+        .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+        .descriptorCount = kMaxTextureCount
+    };
+
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+        .maxSets = 1,
+        .poolSizeCount = 1,
+        .pPoolSizes = &poolSize
+    };
+
+    VK_CHECK_ERROR(vkCreateDescriptorPool(mDevice,
+                                          &descriptorPoolCreateInfo,
+                                          mHostAllocator.callbacks(VK_OBJECT_TYPE_DESCRIPTOR_POOL),
+                                          &mDescriptorPool));
+
+    // ================================================================================
+    // 3. VkDescriptorSet 할당
+    // ================================================================================
+    VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .descriptorPool = mDescriptorPool,
+        .descriptorSetCount = 1,
+        .pSetLayouts = &mDescriptorSetLayout
+    };
+
+    VK_CHECK_ERROR(vkAllocateDescriptorSets(mDevice, &descriptorSetAllocateInfo, &mDescriptorSet));
+}
+
+VkBindlessTable::~VkBindlessTable() {
+    // 레이아웃은 VkObjectCache가 소유한다.
+    vkDestroyDescriptorPool(mDevice,
+                            mDescriptorPool,
+                            mHostAllocator.callbacks(VK_OBJECT_TYPE_DESCRIPTOR_POOL));
+}
+
+uint32_t VkBindlessTable::add(VkImageView imageView, VkSampler sampler) {
+    assert(mTextureCount != kMaxTextureCount);
+
+    VkDescriptorImageInfo descriptorImageInfo{
+        .sampler = sampler,
+        .imageView = imageView,
+        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+    };
+
+    // UPDATE_AFTER_BIND이므로 이미 바인딩된 세트여도 사용되지 않는 슬롯은 바로 쓸 수 있다.
+    VkWriteDescriptorSet writeDescriptorSet{
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstSet = mDescriptorSet,
+        .dstBinding = 0,
+        .dstArrayElement = mTextureCount,
+        .descriptorCount = 1,
+        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+        .pImageInfo = &descriptorImageInfo
+    };
+
+    vkUpdateDescriptorSets(mDevice, 1, &writeDescriptorSet, 0, nullptr);
+
+    return mTextureCount++;
+}
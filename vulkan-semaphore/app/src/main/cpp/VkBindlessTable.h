@@ -0,0 +1,66 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKBINDLESSTABLE_H
+#define PRACTICE_VULKAN_VKBINDLESSTABLE_H
+
+#include <cstdint>
+#include <vulkan/vulkan.h>
+
+#include "VkHostAllocator.h"
+#include "VkObjectCache.h"
+
+/*!
+ * One global descriptor set holding every texture in a combined image sampler array.
+ *
+ * The binding is created with UPDATE_AFTER_BIND and PARTIALLY_BOUND from descriptor indexing,
+ * so add() can write a new slot while earlier command buffers that bound the set are still in
+ * flight, and unused slots never have to be filled. Shaders select a texture by the integer
+ * index add() returns, which lets the renderer bind the set once per frame instead of
+ * allocating and updating a set for every draw.
+ */
+class VkBindlessTable {
+public:
+    // 셰이더의 배열 크기와 같아야 한다.
+    static constexpr uint32_t kMaxTextureCount = 1024;
+
+    VkBindlessTable(VkHostAllocator &hostAllocator, VkDevice device, VkObjectCache &objectCache);
+    ~VkBindlessTable();
+
+    VkBindlessTable(const VkBindlessTable &) = delete;
+    VkBindlessTable &operator=(const VkBindlessTable &) = delete;
+
+    uint32_t add(VkImageView imageView, VkSampler sampler);
+    VkDescriptorSetLayout descriptorSetLayout() const { return mDescriptorSetLayout; }
+    VkDescriptorSet descriptorSet() const { return mDescriptorSet; }
+    uint32_t textureCount() const { return mTextureCount; }
+
+private:
+    VkHostAllocator &mHostAllocator;
+    VkDevice mDevice;
+    VkDescriptorSetLayout mDescriptorSetLayout;
+    VkDescriptorPool mDescriptorPool;
+    VkDescriptorSet mDescriptorSet;
+    uint32_t mTextureCount = 0;
+};
+
+#endif //PRACTICE_VULKAN_VKBINDLESSTABLE_H
@@ -0,0 +1,123 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+
+#include "VkDamageTracker.h"
+
+using namespace std;
+
+namespace {
+
+VkRectLayerKHR unite(const VkRectLayerKHR &a, const VkRectLayerKHR &b) {
+    auto minX = min(a.offset.x, b.offset.x);
+    auto minY = min(a.offset.y, b.offset.y);
+    auto maxX = max(a.offset.x + static_cast<int32_t>(a.extent.width),
+                    b.offset.x + static_cast<int32_t>(b.extent.width));
+    auto maxY = max(a.offset.y + static_cast<int32_t>(a.extent.height),
+                    b.offset.y + static_cast<int32_t>(b.extent.height));
+    return {
+        .offset = {minX, minY},
+        .extent = {static_cast<uint32_t>(maxX - minX), static_cast<uint32_t>(maxY - minY)},
+        .layer = 0
+    };
+}
+
+bool overlaps(const VkRectLayerKHR &a, const VkRectLayerKHR &b) {
+    return a.offset.x <= b.offset.x + static_cast<int32_t>(b.extent.width) &&
+           b.offset.x <= a.offset.x + static_cast<int32_t>(a.extent.width) &&
+           a.offset.y <= b.offset.y + static_cast<int32_t>(b.extent.height) &&
+           b.offset.y <= a.offset.y + static_cast<int32_t>(a.extent.height);
+}
+
+uint64_t area(const VkRectLayerKHR &rect) {
+    return static_cast<uint64_t>(rect.extent.width) * rect.extent.height;
+}
+
+}
+
+VkDamageTracker::VkDamageTracker(VkExtent2D extent)
+        : mExtent(extent) {
+    mRectangles.reserve(kMaxRectangleCount + 1);
+}
+
+void VkDamageTracker::add(VkRect2D rect) {
+    if (mFull) {
+        return;
+    }
+
+    // ================================================================================
+    // 1. 이미지 범위로 자르기
+    // ================================================================================
+    auto minX = max(rect.offset.x, 0);
+    auto minY = max(rect.offset.y, 0);
+    auto maxX = min(rect.offset.x + static_cast<int32_t>(rect.extent.width),
+                    static_cast<int32_t>(mExtent.width));
+    auto maxY = min(rect.offset.y + static_cast<int32_t>(rect.extent.height),
+                    static_cast<int32_t>(mExtent.height));
+    if (minX >= maxX || minY >= maxY) {
+        return;
+    }
+
+    VkRectLayerKHR rectangle{
+        .offset = {minX, minY},
+        .extent = {static_cast<uint32_t>(maxX - minX), static_cast<uint32_t>(maxY - minY)},
+        .layer = 0
+    };
+
+    // ================================================================================
+    // 2. 겹치는 사각형과 합치기
+    // ================================================================================
+    for (auto &damage: mRectangles) {
+        if (overlaps(damage, rectangle)) {
+            damage = unite(damage, rectangle);
+            return;
+        }
+    }
+
+    mRectangles.push_back(rectangle);
+    if (mRectangles.size() > kMaxRectangleCount) {
+        collapse();
+    }
+}
+
+void VkDamageTracker::reset() {
+    mFull = false;
+    mRectangles.clear();
+}
+
+const vector<VkRectLayerKHR> &VkDamageTracker::rectangles() const {
+    return mFull ? mEmptyRectangles : mRectangles;
+}
+
+void VkDamageTracker::collapse() {
+    auto bounds = mRectangles.front();
+    for (const auto &damage: mRectangles) {
+        bounds = unite(bounds, damage);
+    }
+    mRectangles.assign(1, bounds);
+
+    // 거의 전체를 덮으면 사각형을 넘기는 것보다 전체로 처리하는 것이 낫다.
+    if (area(bounds) * 4 >= static_cast<uint64_t>(mExtent.width) * mExtent.height * 3) {
+        mFull = true;
+    }
+}
@@ -0,0 +1,63 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKDAMAGETRACKER_H
+#define PRACTICE_VULKAN_VKDAMAGETRACKER_H
+
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+/*!
+ * Collects the swapchain image rectangles that changed since the previous present.
+ *
+ * Overlapping rectangles are merged. Once there are more than kMaxRectangleCount, they
+ * collapse into their bounding box. A box covering most of the image is treated as a full
+ * damage. The result is passed to VK_KHR_incremental_present so the compositor only re-reads
+ * the changed regions. An empty rectangle list with isFull() means the whole image changed,
+ * which is also how VkPresentRegionKHR reads a rectangleCount of 0.
+ */
+class VkDamageTracker {
+public:
+    explicit VkDamageTracker(VkExtent2D extent);
+
+    void addFull() { mFull = true; }
+    void add(VkRect2D rect);
+    void reset();
+
+    bool isFull() const { return mFull; }
+    bool isEmpty() const { return !mFull && mRectangles.empty(); }
+    // 전체가 바뀌었으면 빈 목록을 반환한다.
+    const std::vector<VkRectLayerKHR> &rectangles() const;
+
+private:
+    static constexpr uint32_t kMaxRectangleCount = 16;
+
+    void collapse();
+
+    VkExtent2D mExtent;
+    bool mFull = true;
+    std::vector<VkRectLayerKHR> mRectangles;
+    std::vector<VkRectLayerKHR> mEmptyRectangles;
+};
+
+#endif //PRACTICE_VULKAN_VKDAMAGETRACKER_H
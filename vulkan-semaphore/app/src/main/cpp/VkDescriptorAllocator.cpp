@@ -0,0 +1,102 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <array>
+#include <cassert>
+
+#include "VkDescriptorAllocator.h"
+#include "VkUtil.h"
+
+using namespace std;
+
+VkDescriptorAllocator::VkDescriptorAllocator(VkHostAllocator &hostAllocator, VkDevice device)
+        : mHostAllocator(hostAllocator),
+          mDevice(device) {
+    mPools.push_back(createPool());
+}
+
+VkDescriptorAllocator::~VkDescriptorAllocator() {
+    for (auto pool : mPools) {
+        vkDestroyDescriptorPool(mDevice,
+                                pool,
+                                mHostAllocator.callbacks(VK_OBJECT_TYPE_DESCRIPTOR_POOL));
+    }
+}
+
+VkDescriptorSet VkDescriptorAllocator::allocate(VkDescriptorSetLayout descriptorSetLayout) {
+    VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .descriptorSetCount = 1,
+        .pSetLayouts = &descriptorSetLayout
+    };
+
+    while (true) {
+        descriptorSetAllocateInfo.descriptorPool = mPools[mPoolIndex];
+
+        VkDescriptorSet descriptorSet;
+        auto result = vkAllocateDescriptorSets(mDevice, &descriptorSetAllocateInfo, &descriptorSet);
+        if (result == VK_SUCCESS) {
+            ++mAllocationCount;
+            return descriptorSet;
+        }
+
+        // 현재 풀이 가득 찼으면 다음 풀로 넘어가고 없으면 새로 만든다.
+        assert(result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL);
+        if (++mPoolIndex == mPools.size()) {
+            mPools.push_back(createPool());
+        }
+    }
+}
+
+void VkDescriptorAllocator::reset() {
+    for (uint32_t i = 0; i <= mPoolIndex && i != mPools.size(); ++i) {
+        VK_CHECK_ERROR(vkResetDescriptorPool(mDevice, mPools[i], 0));
+    }
+
+    mPoolIndex = 0;
+    mAllocationCount = 0;
+}
+
+VkDescriptorPool VkDescriptorAllocator::createPool() {
+    // 대부분의 세트는 텍스처와 유니폼 몇 개로 이루어져 있다고 가정한다.
+    array<VkDescriptorPoolSize, 4> poolSizes{
+        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, kSetCountPerPool * 2},
+        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, kSetCountPerPool},
+        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, kSetCountPerPool},
+        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, kSetCountPerPool}
+    };
+
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .maxSets = kSetCountPerPool,
+        .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+        .pPoolSizes = poolSizes.data()
+    };
+
+    VkDescriptorPool pool;
+    VK_CHECK_ERROR(vkCreateDescriptorPool(mDevice,
+                                          &descriptorPoolCreateInfo,
+                                          mHostAllocator.callbacks(VK_OBJECT_TYPE_DESCRIPTOR_POOL),
+                                          &pool));
+
+    return pool;
+}
@@ -0,0 +1,65 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKDESCRIPTORALLOCATOR_H
+#define PRACTICE_VULKAN_VKDESCRIPTORALLOCATOR_H
+
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "VkHostAllocator.h"
+
+/*!
+ * Linear VkDescriptorSet allocator for one frame in flight.
+ *
+ * Sets are carved out of a list of pools that grows whenever the current pool runs out, and
+ * reset() recycles every pool with vkResetDescriptorPool once the frame's fence has signaled.
+ * Individual sets are never freed, so the pools are created without
+ * VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT.
+ */
+class VkDescriptorAllocator {
+public:
+    VkDescriptorAllocator(VkHostAllocator &hostAllocator, VkDevice device);
+    ~VkDescriptorAllocator();
+
+    VkDescriptorAllocator(const VkDescriptorAllocator &) = delete;
+    VkDescriptorAllocator &operator=(const VkDescriptorAllocator &) = delete;
+
+    VkDescriptorSet allocate(VkDescriptorSetLayout descriptorSetLayout);
+    void reset();
+    uint32_t poolCount() const { return static_cast<uint32_t>(mPools.size()); }
+    uint32_t allocationCount() const { return mAllocationCount; }
+
+private:
+    static constexpr uint32_t kSetCountPerPool = 256;
+
+    VkDescriptorPool createPool();
+
+    VkHostAllocator &mHostAllocator;
+    VkDevice mDevice;
+    std::vector<VkDescriptorPool> mPools;
+    uint32_t mPoolIndex = 0;
+    uint32_t mAllocationCount = 0;
+};
+
+#endif //PRACTICE_VULKAN_VKDESCRIPTORALLOCATOR_H
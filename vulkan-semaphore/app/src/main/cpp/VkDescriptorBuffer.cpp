@@ -0,0 +1,161 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cassert>
+#include <cstring>
+
+#include "VkDescriptorBuffer.h"
+#include "VkUtil.h"
+
+using namespace std;
+
+VkDescriptorBuffer::VkDescriptorBuffer(
+        VkHostAllocator &hostAllocator,
+        VkMemoryBudget &memoryBudget,
+        VkDevice device,
+        VkObjectCache &objectCache,
+        const VkPhysicalDeviceDescriptorBufferPropertiesEXT &properties,
+        uint32_t frameCount)
+        : mDevice(device),
+          mDescriptorSize(properties.combinedImageSamplerDescriptorSize) {
+    // ================================================================================
+    // 1. 함수 포인터 얻기
+    // ================================================================================
+    mGetDescriptorSetLayoutSize = vkGetDeviceProc<PFN_vkGetDescriptorSetLayoutSizeEXT>(
+            mDevice, {"vkGetDescriptorSetLayoutSizeEXT"});
+    mGetDescriptorSetLayoutBindingOffset =
+            vkGetDeviceProc<PFN_vkGetDescriptorSetLayoutBindingOffsetEXT>(
+                    mDevice, {"vkGetDescriptorSetLayoutBindingOffsetEXT"});
+    mGetDescriptor = vkGetDeviceProc<PFN_vkGetDescriptorEXT>(mDevice, {"vkGetDescriptorEXT"});
+    mCmdBindDescriptorBuffers = vkGetDeviceProc<PFN_vkCmdBindDescriptorBuffersEXT>(
+            mDevice, {"vkCmdBindDescriptorBuffersEXT"});
+    mCmdSetDescriptorBufferOffsets = vkGetDeviceProc<PFN_vkCmdSetDescriptorBufferOffsetsEXT>(
+            mDevice, {"vkCmdSetDescriptorBufferOffsetsEXT"});
+    assert(mGetDescriptorSetLayoutSize && mGetDescriptorSetLayoutBindingOffset &&
+           mGetDescriptor && mCmdBindDescriptorBuffers && mCmdSetDescriptorBufferOffsets);
+
+    // ================================================================================
+    // 2. VkDescriptorSetLayout 생성
+    // ================================================================================
+    VkDescriptorSetLayoutBinding descriptorSetLayoutBinding{
+        .binding = 0,
+        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+        .descriptorCount = 1,
+        .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT
+    };
+
+    VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT,
+        .bindingCount = 1,
+        .pBindings = &descriptorSetLayoutBinding
+    };
+
+    mDescriptorSetLayout = objectCache.descriptorSetLayout(descriptorSetLayoutCreateInfo);
+
+    // 세트의 시작 위치는 descriptorBufferOffsetAlignment에 맞춰야 한다.
+    mGetDescriptorSetLayoutSize(mDevice, mDescriptorSetLayout, &mSetSize);
+    mSetSize = alignUp(mSetSize, properties.descriptorBufferOffsetAlignment);
+    mGetDescriptorSetLayoutBindingOffset(mDevice, mDescriptorSetLayout, 0, &mBindingOffset);
+
+    // ================================================================================
+    // 3. 프레임 수만큼 나눠 쓰는 링 VkBuffer 생성
+    // ================================================================================
+    mBuffer = make_unique<VkDeviceBuffer>(hostAllocator,
+                                          memoryBudget,
+                                          mDevice,
+                                          mSetSize * kSetCountPerFrame * frameCount,
+                                          VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT |
+                                          VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT |
+                                          VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                          VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    mMappedData = static_cast<uint8_t *>(mBuffer->mappedData());
+}
+
+uint32_t VkDescriptorBuffer::addTexture(VkImageView imageView, VkSampler sampler) {
+    VkDescriptorImageInfo descriptorImageInfo{
+        .sampler = sampler,
+        .imageView = imageView,
+        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+    };
+
+    VkDescriptorGetInfoEXT descriptorGetInfo{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
+        .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+        .data = {.pCombinedImageSampler = &descriptorImageInfo}
+    };
+
+    // 드라이버가 만든 디스크립터 바이트를 보관해두고 바인딩할 때마다 복사만 한다.
+    auto textureIndex = static_cast<uint32_t>(mTextureSlots.size());
+    mTextureDescriptors.resize(mDescriptorSize * (textureIndex + 1));
+    mGetDescriptor(mDevice,
+                   &descriptorGetInfo,
+                   mDescriptorSize,
+                   &mTextureDescriptors[mDescriptorSize * textureIndex]);
+    mTextureSlots.push_back(kInvalidSlot);
+
+    return textureIndex;
+}
+
+void VkDescriptorBuffer::beginFrame(uint32_t frameIndex) {
+    mFrameOffset = mSetSize * kSetCountPerFrame * frameIndex;
+    mSetCount = 0;
+    fill(mTextureSlots.begin(), mTextureSlots.end(), kInvalidSlot);
+}
+
+void VkDescriptorBuffer::bind(VkCommandBuffer commandBuffer) {
+    VkDescriptorBufferBindingInfoEXT descriptorBufferBindingInfo{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT,
+        .address = mBuffer->deviceAddress(),
+        .usage = VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT |
+                 VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT
+    };
+
+    mCmdBindDescriptorBuffers(commandBuffer, 1, &descriptorBufferBindingInfo);
+}
+
+void VkDescriptorBuffer::bindTexture(VkCommandBuffer commandBuffer,
+                                     VkPipelineLayout pipelineLayout,
+                                     uint32_t textureIndex) {
+    assert(textureIndex < mTextureSlots.size());
+
+    // 같은 프레임에서 이미 기록한 텍스처는 오프셋만 다시 설정한다.
+    auto &slot = mTextureSlots[textureIndex];
+    if (slot == kInvalidSlot) {
+        assert(mSetCount != kSetCountPerFrame);
+        slot = mSetCount++;
+        memcpy(mMappedData + mFrameOffset + mSetSize * slot + mBindingOffset,
+               &mTextureDescriptors[mDescriptorSize * textureIndex],
+               mDescriptorSize);
+    }
+
+    uint32_t bufferIndex = 0;
+    VkDeviceSize offset = mFrameOffset + mSetSize * slot;
+    mCmdSetDescriptorBufferOffsets(commandBuffer,
+                                   VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                   pipelineLayout,
+                                   0,
+                                   1,
+                                   &bufferIndex,
+                                   &offset);
+}
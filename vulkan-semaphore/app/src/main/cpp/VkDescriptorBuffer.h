@@ -0,0 +1,88 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKDESCRIPTORBUFFER_H
+#define PRACTICE_VULKAN_VKDESCRIPTORBUFFER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "VkDeviceBuffer.h"
+#include "VkHostAllocator.h"
+#include "VkMemoryBudget.h"
+#include "VkObjectCache.h"
+
+/*!
+ * Texture descriptors written straight into GPU visible memory with VK_EXT_descriptor_buffer.
+ *
+ * There are no pools or VkDescriptorSet objects. Each texture's descriptor is fetched once
+ * with vkGetDescriptorEXT, and binding it copies those bytes into a persistently mapped ring
+ * with memcpy and points the set at them with vkCmdSetDescriptorBufferOffsetsEXT. Pipelines
+ * that use the layout must be created with VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT.
+ */
+class VkDescriptorBuffer {
+public:
+    VkDescriptorBuffer(VkHostAllocator &hostAllocator,
+                       VkMemoryBudget &memoryBudget,
+                       VkDevice device,
+                       VkObjectCache &objectCache,
+                       const VkPhysicalDeviceDescriptorBufferPropertiesEXT &properties,
+                       uint32_t frameCount);
+
+    VkDescriptorBuffer(const VkDescriptorBuffer &) = delete;
+    VkDescriptorBuffer &operator=(const VkDescriptorBuffer &) = delete;
+
+    uint32_t addTexture(VkImageView imageView, VkSampler sampler);
+    void beginFrame(uint32_t frameIndex);
+    void bind(VkCommandBuffer commandBuffer);
+    void bindTexture(VkCommandBuffer commandBuffer,
+                     VkPipelineLayout pipelineLayout,
+                     uint32_t textureIndex);
+    VkDescriptorSetLayout descriptorSetLayout() const { return mDescriptorSetLayout; }
+
+private:
+    static constexpr uint32_t kSetCountPerFrame = 256;
+    static constexpr uint32_t kInvalidSlot = UINT32_MAX;
+
+    VkDevice mDevice;
+    VkDescriptorSetLayout mDescriptorSetLayout;
+    VkDeviceSize mSetSize;
+    VkDeviceSize mBindingOffset;
+    size_t mDescriptorSize;
+    std::vector<uint8_t> mTextureDescriptors;
+    std::unique_ptr<VkDeviceBuffer> mBuffer;
+    uint8_t *mMappedData;
+    VkDeviceSize mFrameOffset = 0;
+    uint32_t mSetCount = 0;
+    // 이번 프레임에 텍스처 디스크립터를 이미 기록한 슬롯
+    std::vector<uint32_t> mTextureSlots;
+
+    PFN_vkGetDescriptorSetLayoutSizeEXT mGetDescriptorSetLayoutSize;
+    PFN_vkGetDescriptorSetLayoutBindingOffsetEXT mGetDescriptorSetLayoutBindingOffset;
+    PFN_vkGetDescriptorEXT mGetDescriptor;
+    PFN_vkCmdBindDescriptorBuffersEXT mCmdBindDescriptorBuffers;
+    PFN_vkCmdSetDescriptorBufferOffsetsEXT mCmdSetDescriptorBufferOffsets;
+};
+
+#endif //PRACTICE_VULKAN_VKDESCRIPTORBUFFER_H
@@ -0,0 +1,118 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cassert>
+
+#include "VkDeviceBuffer.h"
+#include "VkUtil.h"
+#include "AndroidOut.h"
+
+using namespace std;
+
+VkDeviceBuffer::VkDeviceBuffer(VkHostAllocator &hostAllocator,
+                               VkMemoryBudget &memoryBudget,
+                               VkDevice device,
+                               VkDeviceSize size,
+                               VkBufferUsageFlags usage,
+                               VkMemoryPropertyFlags memoryPropertyFlags)
+        : mHostAllocator(hostAllocator),
+          mMemoryBudget(memoryBudget),
+          mDevice(device),
+          mSize(size) {
+    // ================================================================================
+    // 1. VkBuffer 생성
+    // ================================================================================
+    VkBufferCreateInfo bufferCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = mSize,
+        .usage = usage,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+    };
+
+    VK_CHECK_ERROR(vkCreateBuffer(mDevice,
+                                  &bufferCreateInfo,
+                                  mHostAllocator.callbacks(VK_OBJECT_TYPE_BUFFER),
+                                  &mBuffer));
+
+    // ================================================================================
+    // 2. VkDeviceMemory 할당 및 바인딩
+    // ================================================================================
+    VkMemoryRequirements memoryRequirements;
+    vkGetBufferMemoryRequirements(mDevice, mBuffer, &memoryRequirements);
+
+    auto deviceAddressEnabled = usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    VkMemoryAllocateFlagsInfo memoryAllocateFlagsInfo{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO,
+        .flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT
+    };
+
+    VkMemoryAllocateInfo memoryAllocateInfo{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .pNext = deviceAddressEnabled ? &memoryAllocateFlagsInfo : nullptr,
+        .allocationSize = memoryRequirements.size,
+        .memoryTypeIndex = vkFindMemoryTypeIndex(mMemoryBudget.memoryProperties(),
+                                                 memoryRequirements.memoryTypeBits,
+                                                 memoryPropertyFlags)
+    };
+    assert(memoryAllocateInfo.memoryTypeIndex != VK_MAX_MEMORY_TYPES);
+
+    VK_CHECK_ERROR(vkAllocateMemory(mDevice,
+                                    &memoryAllocateInfo,
+                                    mHostAllocator.callbacks(VK_OBJECT_TYPE_DEVICE_MEMORY),
+                                    &mMemory));
+    mMemoryTypeIndex = memoryAllocateInfo.memoryTypeIndex;
+    mMemorySize = memoryAllocateInfo.allocationSize;
+    mMemoryBudget.onAllocate(mMemoryTypeIndex, mMemorySize);
+
+    VK_CHECK_ERROR(vkBindBufferMemory(mDevice, mBuffer, mMemory, 0));
+
+    // ================================================================================
+    // 3. Host visible 메모리 매핑
+    // ================================================================================
+    if (memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+        VK_CHECK_ERROR(vkMapMemory(mDevice, mMemory, 0, VK_WHOLE_SIZE, 0, &mMappedData));
+    }
+
+    // ================================================================================
+    // 4. Device address 얻기
+    // ================================================================================
+    if (deviceAddressEnabled) {
+        auto getBufferDeviceAddress = vkGetDeviceProc<PFN_vkGetBufferDeviceAddress>(
+                mDevice, {"vkGetBufferDeviceAddress", "vkGetBufferDeviceAddressKHR"});
+        assert(getBufferDeviceAddress);
+
+        VkBufferDeviceAddressInfo bufferDeviceAddressInfo{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+            .buffer = mBuffer
+        };
+        mDeviceAddress = getBufferDeviceAddress(mDevice, &bufferDeviceAddressInfo);
+    }
+}
+
+VkDeviceBuffer::~VkDeviceBuffer() {
+    if (mMappedData) {
+        vkUnmapMemory(mDevice, mMemory);
+    }
+    vkFreeMemory(mDevice, mMemory, mHostAllocator.callbacks(VK_OBJECT_TYPE_DEVICE_MEMORY));
+    mMemoryBudget.onFree(mMemoryTypeIndex, mMemorySize);
+    vkDestroyBuffer(mDevice, mBuffer, mHostAllocator.callbacks(VK_OBJECT_TYPE_BUFFER));
+}
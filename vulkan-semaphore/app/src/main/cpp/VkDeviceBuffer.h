@@ -0,0 +1,69 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKDEVICEBUFFER_H
+#define PRACTICE_VULKAN_VKDEVICEBUFFER_H
+
+#include <vulkan/vulkan.h>
+
+#include "VkHostAllocator.h"
+#include "VkMemoryBudget.h"
+
+/*!
+ * VkBuffer with its own VkDeviceMemory.
+ *
+ * Host visible buffers stay mapped for their whole lifetime so that the CPU can write into
+ * them with a plain memcpy. Buffers created with VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+ * also expose their device address.
+ */
+class VkDeviceBuffer {
+public:
+    VkDeviceBuffer(VkHostAllocator &hostAllocator,
+                   VkMemoryBudget &memoryBudget,
+                   VkDevice device,
+                   VkDeviceSize size,
+                   VkBufferUsageFlags usage,
+                   VkMemoryPropertyFlags memoryPropertyFlags);
+    ~VkDeviceBuffer();
+
+    VkDeviceBuffer(const VkDeviceBuffer &) = delete;
+    VkDeviceBuffer &operator=(const VkDeviceBuffer &) = delete;
+
+    VkBuffer buffer() const { return mBuffer; }
+    VkDeviceSize size() const { return mSize; }
+    void *mappedData() const { return mMappedData; }
+    VkDeviceAddress deviceAddress() const { return mDeviceAddress; }
+
+private:
+    VkHostAllocator &mHostAllocator;
+    VkMemoryBudget &mMemoryBudget;
+    VkDevice mDevice;
+    VkDeviceSize mSize;
+    VkBuffer mBuffer;
+    VkDeviceMemory mMemory;
+    uint32_t mMemoryTypeIndex;
+    VkDeviceSize mMemorySize;
+    void *mMappedData = nullptr;
+    VkDeviceAddress mDeviceAddress = 0;
+};
+
+#endif //PRACTICE_VULKAN_VKDEVICEBUFFER_H
@@ -0,0 +1,129 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <array>
+#include <cassert>
+#include <cstring>
+
+#include "VkDrawBatcher.h"
+
+using namespace std;
+
+VkDrawBatcher::VkDrawBatcher(VkHostAllocator &hostAllocator,
+                             VkMemoryBudget &memoryBudget,
+                             VkDevice device,
+                             uint32_t instanceSize,
+                             uint32_t maxInstanceCount,
+                             uint32_t frameCount)
+        : mInstanceSize(instanceSize),
+          mMaxInstanceCount(maxInstanceCount) {
+    mBuffer = make_unique<VkDeviceBuffer>(hostAllocator,
+                                          memoryBudget,
+                                          device,
+                                          static_cast<VkDeviceSize>(mInstanceSize) *
+                                          mMaxInstanceCount * frameCount,
+                                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                          VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    mMappedData = static_cast<uint8_t *>(mBuffer->mappedData());
+
+    // 매 프레임 할당하지 않도록 최대 개수만큼 미리 확보한다.
+    mInstanceData.reserve(static_cast<size_t>(mInstanceSize) * mMaxInstanceCount);
+    mItems.reserve(mMaxInstanceCount);
+    mSortedItems.reserve(mMaxInstanceCount);
+    mBatches.reserve(mMaxInstanceCount);
+}
+
+void VkDrawBatcher::beginFrame(uint32_t frameIndex) {
+    mFrameOffset = static_cast<VkDeviceSize>(mInstanceSize) * mMaxInstanceCount * frameIndex;
+    mInstanceData.clear();
+    mItems.clear();
+    mBatches.clear();
+}
+
+void VkDrawBatcher::add(uint64_t key, const void *instanceData) {
+    assert(mItems.size() != mMaxInstanceCount);
+    auto index = static_cast<uint32_t>(mItems.size());
+    auto data = static_cast<const uint8_t *>(instanceData);
+    mInstanceData.insert(mInstanceData.end(), data, data + mInstanceSize);
+    mItems.push_back({key, index});
+}
+
+const vector<VkDrawBatcher::Batch> &VkDrawBatcher::build() {
+    // ================================================================================
+    // 1. 키 정렬
+    // ================================================================================
+    sort();
+
+    // ================================================================================
+    // 2. 정렬된 순서로 인스턴스 데이터 복사 및 배치 생성
+    // ================================================================================
+    auto dst = mMappedData + mFrameOffset;
+    for (uint32_t i = 0; i != mItems.size(); ++i) {
+        const auto &item = mItems[i];
+        memcpy(dst + static_cast<size_t>(mInstanceSize) * i,
+               mInstanceData.data() + static_cast<size_t>(mInstanceSize) * item.index,
+               mInstanceSize);
+
+        if (mBatches.empty() || mBatches.back().key != item.key) {
+            mBatches.push_back({item.key, i, 0});
+        }
+        ++mBatches.back().instanceCount;
+    }
+
+    return mBatches;
+}
+
+void VkDrawBatcher::sort() {
+    // 8비트씩 LSD 기수 정렬을 한다. 안정 정렬이므로 같은 키 안에서는 추가한 순서가 유지된다.
+    constexpr uint32_t kRadixBits = 8;
+    constexpr uint32_t kRadixSize = 1 << kRadixBits;
+    auto count = mItems.size();
+    if (count < 2) {
+        return;
+    }
+    mSortedItems.resize(count);
+
+    for (uint32_t shift = 0; shift != 64; shift += kRadixBits) {
+        array<size_t, kRadixSize> histogram{};
+        for (const auto &item: mItems) {
+            ++histogram[(item.key >> shift) & (kRadixSize - 1)];
+        }
+
+        // 모든 키가 이 자릿수에서 같으면 순서가 바뀌지 않으므로 건너뛴다.
+        if (histogram[(mItems.front().key >> shift) & (kRadixSize - 1)] == count) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (auto &bucket: histogram) {
+            auto size = bucket;
+            bucket = offset;
+            offset += size;
+        }
+
+        for (const auto &item: mItems) {
+            mSortedItems[histogram[(item.key >> shift) & (kRadixSize - 1)]++] = item;
+        }
+        mItems.swap(mSortedItems);
+    }
+}
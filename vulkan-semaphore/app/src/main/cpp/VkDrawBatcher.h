@@ -0,0 +1,100 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKDRAWBATCHER_H
+#define PRACTICE_VULKAN_VKDRAWBATCHER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "VkDeviceBuffer.h"
+#include "VkHostAllocator.h"
+#include "VkMemoryBudget.h"
+
+/*!
+ * Groups per-object draws into instanced draws.
+ *
+ * Each object is added with a 64-bit sort key built by makeKey() and its per-instance data.
+ * build() radix-sorts the objects by key, packs their instance data back to back into a
+ * persistently mapped vertex buffer and returns one batch per run of equal keys. Each batch
+ * becomes a single vkCmdDrawIndexed whose firstInstance points at its first instance.
+ */
+class VkDrawBatcher {
+public:
+    struct Batch {
+        uint64_t key;
+        uint32_t firstInstance;
+        uint32_t instanceCount;
+    };
+
+    // 상위 비트부터 파이프라인, 메시, 머티리얼 순서로 정렬된다. 하위 16비트는 비워둔다.
+    static uint64_t makeKey(uint16_t pipeline, uint16_t mesh, uint16_t material) {
+        return static_cast<uint64_t>(pipeline) << 48 |
+               static_cast<uint64_t>(mesh) << 32 |
+               static_cast<uint64_t>(material) << 16;
+    }
+    static uint16_t pipeline(uint64_t key) { return static_cast<uint16_t>(key >> 48); }
+    static uint16_t mesh(uint64_t key) { return static_cast<uint16_t>(key >> 32); }
+    static uint16_t material(uint64_t key) { return static_cast<uint16_t>(key >> 16); }
+
+    VkDrawBatcher(VkHostAllocator &hostAllocator,
+                  VkMemoryBudget &memoryBudget,
+                  VkDevice device,
+                  uint32_t instanceSize,
+                  uint32_t maxInstanceCount,
+                  uint32_t frameCount);
+
+    VkDrawBatcher(const VkDrawBatcher &) = delete;
+    VkDrawBatcher &operator=(const VkDrawBatcher &) = delete;
+
+    void beginFrame(uint32_t frameIndex);
+    void add(uint64_t key, const void *instanceData);
+    const std::vector<Batch> &build();
+
+    // 이번 프레임의 인스턴스 데이터를 vertex 버퍼로 바인딩할 때 사용한다.
+    VkBuffer buffer() const { return mBuffer->buffer(); }
+    VkDeviceSize offset() const { return mFrameOffset; }
+    // build() 이후 정렬된 인스턴스가 몇 번째로 추가된 오브젝트인지 반환한다.
+    uint32_t sourceIndex(uint32_t instance) const { return mItems[instance].index; }
+
+private:
+    struct Item {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    void sort();
+
+    uint32_t mInstanceSize;
+    uint32_t mMaxInstanceCount;
+    std::unique_ptr<VkDeviceBuffer> mBuffer;
+    uint8_t *mMappedData;
+    VkDeviceSize mFrameOffset = 0;
+    std::vector<uint8_t> mInstanceData;
+    std::vector<Item> mItems;
+    std::vector<Item> mSortedItems;
+    std::vector<Batch> mBatches;
+};
+
+#endif //PRACTICE_VULKAN_VKDRAWBATCHER_H
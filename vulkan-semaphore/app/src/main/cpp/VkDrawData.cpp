@@ -0,0 +1,149 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cassert>
+#include <cstring>
+
+#include "VkDrawData.h"
+#include "VkUtil.h"
+
+using namespace std;
+
+VkDrawData::VkDrawData(VkHostAllocator &hostAllocator,
+                       VkMemoryBudget &memoryBudget,
+                       VkDevice device,
+                       VkObjectCache &objectCache,
+                       const VkPhysicalDeviceLimits &limits,
+                       bool pushDescriptorEnabled,
+                       bool preferPushDescriptor,
+                       VkShaderStageFlags stageFlags,
+                       uint32_t dataSize,
+                       uint32_t set,
+                       uint32_t maxDrawCount,
+                       uint32_t frameCount)
+        : mStageFlags(stageFlags),
+          mDataSize(dataSize),
+          mSet(set),
+          mMaxDrawCount(maxDrawCount) {
+    // ================================================================================
+    // 1. 경로 선택
+    // ================================================================================
+    // Push constant가 가장 싸므로 크기가 허용하면 항상 사용한다.
+    auto fitsPushConstants = dataSize <= limits.maxPushConstantsSize;
+    if (!pushDescriptorEnabled) {
+        assert(fitsPushConstants);
+        mPath = kPushConstants;
+    } else {
+        mPath = fitsPushConstants && !preferPushDescriptor ? kPushConstants : kPushDescriptor;
+    }
+
+    if (mPath == kPushConstants) {
+        return;
+    }
+
+    // ================================================================================
+    // 2. Push descriptor VkDescriptorSetLayout 생성
+    // ================================================================================
+    mCmdPushDescriptorSet = vkGetDeviceProc<PFN_vkCmdPushDescriptorSetKHR>(
+            device, {"vkCmdPushDescriptorSetKHR"});
+    assert(mCmdPushDescriptorSet);
+    assert(dataSize <= limits.maxUniformBufferRange);
+
+    VkDescriptorSetLayoutBinding descriptorSetLayoutBinding{
+        .binding = 0,
+        .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+        .descriptorCount = 1,
+        .stageFlags = stageFlags
+    };
+
+    VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR,
+        .bindingCount = 1,
+        .pBindings = &descriptorSetLayoutBinding
+    };
+
+    mDescriptorSetLayout = objectCache.descriptorSetLayout(descriptorSetLayoutCreateInfo);
+
+    // ================================================================================
+    // 3. 프레임 수만큼 나눠 쓰는 uniform 링 VkBuffer 생성
+    // ================================================================================
+    mStride = alignUp<VkDeviceSize>(dataSize, limits.minUniformBufferOffsetAlignment);
+    mBuffer = make_unique<VkDeviceBuffer>(hostAllocator,
+                                          memoryBudget,
+                                          device,
+                                          mStride * mMaxDrawCount * frameCount,
+                                          VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                          VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    mMappedData = static_cast<uint8_t *>(mBuffer->mappedData());
+}
+
+VkPushConstantRange VkDrawData::pushConstantRange() const {
+    assert(mPath == kPushConstants);
+    return {
+        .stageFlags = mStageFlags,
+        .offset = 0,
+        .size = mDataSize
+    };
+}
+
+void VkDrawData::beginFrame(uint32_t frameIndex) {
+    mFrameOffset = mStride * mMaxDrawCount * frameIndex;
+    mDrawCount = 0;
+}
+
+void VkDrawData::push(VkCommandBuffer commandBuffer,
+                      VkPipelineLayout pipelineLayout,
+                      const void *data) {
+    if (mPath == kPushConstants) {
+        vkCmdPushConstants(commandBuffer, pipelineLayout, mStageFlags, 0, mDataSize, data);
+        return;
+    }
+
+    // 링에 복사한 범위를 세트 없이 바로 커맨드 버퍼에 기록한다.
+    assert(mDrawCount != mMaxDrawCount);
+    auto offset = mFrameOffset + mStride * mDrawCount++;
+    memcpy(mMappedData + offset, data, mDataSize);
+
+    VkDescriptorBufferInfo descriptorBufferInfo{
+        .buffer = mBuffer->buffer(),
+        .offset = offset,
+        .range = mDataSize
+    };
+
+    VkWriteDescriptorSet writeDescriptorSet{
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstBinding = 0,
+        .dstArrayElement = 0,
+        .descriptorCount = 1,
+        .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+        .pBufferInfo = &descriptorBufferInfo
+    };
+
+    mCmdPushDescriptorSet(commandBuffer,
+                          VK_PIPELINE_BIND_POINT_GRAPHICS,
+                          pipelineLayout,
+                          mSet,
+                          1,
+                          &writeDescriptorSet);
+}
@@ -0,0 +1,89 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKDRAWDATA_H
+#define PRACTICE_VULKAN_VKDRAWDATA_H
+
+#include <cstdint>
+#include <memory>
+#include <vulkan/vulkan.h>
+
+#include "VkDeviceBuffer.h"
+#include "VkHostAllocator.h"
+#include "VkMemoryBudget.h"
+#include "VkObjectCache.h"
+
+/*!
+ * Small per-draw data recorded without allocating or updating descriptor sets.
+ *
+ * Data that fits in maxPushConstantsSize goes through vkCmdPushConstants. Larger data, or a
+ * request for push descriptors, is copied into a persistently mapped uniform ring and bound
+ * with vkCmdPushDescriptorSetKHR from VK_KHR_push_descriptor.
+ */
+class VkDrawData {
+public:
+    enum Path {
+        kPushConstants,
+        kPushDescriptor
+    };
+
+    VkDrawData(VkHostAllocator &hostAllocator,
+               VkMemoryBudget &memoryBudget,
+               VkDevice device,
+               VkObjectCache &objectCache,
+               const VkPhysicalDeviceLimits &limits,
+               bool pushDescriptorEnabled,
+               bool preferPushDescriptor,
+               VkShaderStageFlags stageFlags,
+               uint32_t dataSize,
+               uint32_t set,
+               uint32_t maxDrawCount,
+               uint32_t frameCount);
+
+    VkDrawData(const VkDrawData &) = delete;
+    VkDrawData &operator=(const VkDrawData &) = delete;
+
+    Path path() const { return mPath; }
+    // 파이프라인 레이아웃에 추가해야 하는 push constant 범위 또는 세트 레이아웃
+    VkPushConstantRange pushConstantRange() const;
+    VkDescriptorSetLayout descriptorSetLayout() const { return mDescriptorSetLayout; }
+
+    void beginFrame(uint32_t frameIndex);
+    void push(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, const void *data);
+
+private:
+    Path mPath;
+    VkShaderStageFlags mStageFlags;
+    uint32_t mDataSize;
+    uint32_t mSet;
+    VkDescriptorSetLayout mDescriptorSetLayout = VK_NULL_HANDLE;
+    VkDeviceSize mStride = 0;
+    uint32_t mMaxDrawCount;
+    std::unique_ptr<VkDeviceBuffer> mBuffer;
+    uint8_t *mMappedData = nullptr;
+    VkDeviceSize mFrameOffset = 0;
+    uint32_t mDrawCount = 0;
+
+    PFN_vkCmdPushDescriptorSetKHR mCmdPushDescriptorSet = nullptr;
+};
+
+#endif //PRACTICE_VULKAN_VKDRAWDATA_H
@@ -0,0 +1,248 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <thread>
+
+#include "VkFramePacer.h"
+#include "VkUtil.h"
+#include "AndroidOut.h"
+
+using namespace std;
+
+VkFramePacer::VkFramePacer(VkDevice device,
+                           VkSwapchainKHR swapchain,
+                           bool displayTimingEnabled,
+                           bool presentWaitEnabled,
+                           uint32_t maxQueuedFrames)
+        : mDevice(device),
+          mSwapchain(swapchain),
+          mDisplayTimingEnabled(displayTimingEnabled),
+          mPresentWaitEnabled(presentWaitEnabled),
+          mMaxQueuedFrames(maxQueuedFrames) {
+    assert(mMaxQueuedFrames);
+
+    if (mPresentWaitEnabled) {
+        mWaitForPresent = vkGetDeviceProc<PFN_vkWaitForPresentKHR>(mDevice,
+                                                                   {"vkWaitForPresentKHR"});
+        mPresentWaitEnabled = mWaitForPresent;
+        mPresentIdInfo = {
+            .sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR,
+            .swapchainCount = 1,
+            .pPresentIds = &mPresentIdValue
+        };
+    }
+
+    if (mDisplayTimingEnabled) {
+        mGetRefreshCycleDuration = vkGetDeviceProc<PFN_vkGetRefreshCycleDurationGOOGLE>(
+                mDevice, {"vkGetRefreshCycleDurationGOOGLE"});
+        mGetPastPresentationTiming = vkGetDeviceProc<PFN_vkGetPastPresentationTimingGOOGLE>(
+                mDevice, {"vkGetPastPresentationTimingGOOGLE"});
+        mDisplayTimingEnabled = mGetRefreshCycleDuration && mGetPastPresentationTiming;
+    }
+
+    if (!mDisplayTimingEnabled) {
+        return;
+    }
+
+    VkRefreshCycleDurationGOOGLE refreshCycleDuration{};
+    if (mGetRefreshCycleDuration(mDevice, mSwapchain, &refreshCycleDuration) == VK_SUCCESS &&
+        refreshCycleDuration.refreshDuration) {
+        mRefreshDuration = refreshCycleDuration.refreshDuration;
+    }
+
+    mPresentTimesInfo = {
+        .sType = VK_STRUCTURE_TYPE_PRESENT_TIMES_INFO_GOOGLE,
+        .swapchainCount = 1,
+        .pTimes = &mPresentTime
+    };
+}
+
+void VkFramePacer::wait() {
+    // 출력했지만 아직 화면에 나가지 않은 프레임이 최대 개수 이하가 될 때까지 기다린다.
+    // 화면이 가려지면 출력이 끝나지 않을 수 있으므로 시간 초과는 그냥 넘어간다.
+    if (mPresentWaitEnabled && mPresentId > mMaxQueuedFrames + 1) {
+        auto result = mWaitForPresent(mDevice,
+                                      mSwapchain,
+                                      mPresentId - mMaxQueuedFrames - 1,
+                                      kPresentWaitTimeout);
+        ++mPresentWaitCount;
+        mPresentWaitTimeoutCount += result == VK_TIMEOUT;
+    }
+
+    auto now = Clock::now();
+    auto slot = mLastPresentTime + chrono::nanoseconds(mRefreshDuration * mSwapInterval);
+
+    // 이전 출력 뒤로 한참 지나서 시작한 프레임(예: 건너뛴 프레임 뒤)은 늦었는지 판단하지 않는다.
+    mOnSchedule = mPresentCount && now < slot;
+
+    if (mDisplayTimingEnabled) {
+        readPastTimings();
+        mFrameStartTime = now;
+        return;
+    }
+
+    // FIFO가 마지막 한 주기는 맞춰 주므로 나머지 주기만큼만 잠든다.
+    if (mOnSchedule && mSwapInterval > 1) {
+        this_thread::sleep_until(slot - chrono::nanoseconds(mRefreshDuration));
+    }
+    mFrameStartTime = Clock::now();
+}
+
+void VkFramePacer::chainPresentInfo(void **presentInfoNext) {
+    if (mPresentWaitEnabled) {
+        mPresentIdValue = mPresentId;
+        vkChain(presentInfoNext, &mPresentIdInfo);
+    }
+
+    if (!mDisplayTimingEnabled) {
+        return;
+    }
+
+    // 피드백이 없거나 이미 슬롯이 지났으면 시각을 지정하지 않고 바로 출력한다.
+    // Android의 출력 시각은 CLOCK_MONOTONIC 기준이므로 steady_clock과 비교할 수 있다.
+    uint64_t desiredPresentTime = 0;
+    if (mLastActualPresentTime && mOnSchedule) {
+        auto cycles = (mPresentId - mLastPresentId) * mSwapInterval;
+        // 반 주기 앞당겨서 시각 오차로 다음 vsync로 밀리지 않게 한다.
+        desiredPresentTime = mLastActualPresentTime + cycles * mRefreshDuration -
+                             mRefreshDuration / 2;
+        auto now = chrono::duration_cast<chrono::nanoseconds>(
+                mFrameStartTime.time_since_epoch()).count();
+        if (desiredPresentTime <= static_cast<uint64_t>(now)) {
+            desiredPresentTime = 0;
+        }
+    }
+
+    mPresentTime = {
+        .presentID = static_cast<uint32_t>(mPresentId),
+        .desiredPresentTime = desiredPresentTime
+    };
+    vkChain(presentInfoNext, &mPresentTimesInfo);
+}
+
+void VkFramePacer::presented() {
+    auto now = Clock::now();
+    ++mPresentId;
+
+    // 추정 모드는 출력 간격으로 주기를 추정하고 늦었는지 판단한다.
+    if (!mDisplayTimingEnabled && mPresentCount) {
+        auto interval = chrono::duration_cast<chrono::nanoseconds>(now - mLastPresentTime);
+        auto cycles = llround(static_cast<double>(interval.count()) / mRefreshDuration);
+        // 큐가 차기 전의 짧은 간격과 화면이 멈춰 있던 긴 간격은 vsync를 알려주지 않는다.
+        if (cycles >= 1 && cycles <= kMaxSwapInterval * 2) {
+            estimateRefreshDuration(interval.count() / cycles);
+        }
+
+        if (mOnSchedule) {
+            auto workTime = chrono::duration_cast<chrono::nanoseconds>(now - mFrameStartTime);
+            auto late = cycles > static_cast<long long>(mSwapInterval);
+            auto early = workTime.count() + mRefreshDuration / 4 <
+                         mRefreshDuration * (mSwapInterval - 1);
+            account(late, early);
+        }
+    }
+
+    mLastPresentTime = now;
+    ++mPresentCount;
+}
+
+void VkFramePacer::report() const {
+    aout << "Frame Pacing Information ↓" << endl;
+    aout << setw(16) << left << " - Mode: "
+         << (mDisplayTimingEnabled ? "Display Timing" : "Estimated") << endl;
+    aout << fixed << setprecision(3);
+    aout << setw(16) << left << " - Refresh: " << mRefreshDuration / 1e6 << " ms" << endl;
+    aout << setw(16) << left << " - Interval: " << mSwapInterval << endl;
+    aout << setw(16) << left << " - Presents: " << mPresentCount << endl;
+    aout << setw(16) << left << " - Late: " << mTotalLateCount << endl;
+    if (mPresentWaitEnabled) {
+        aout << setw(16) << left << " - Max Queued: " << mMaxQueuedFrames << endl;
+        aout << setw(16) << left << " - Waits: " << mPresentWaitCount
+             << " (" << mPresentWaitTimeoutCount << " timed out)" << endl;
+    }
+}
+
+void VkFramePacer::readPastTimings() {
+    uint32_t timingCount = 0;
+    auto result = mGetPastPresentationTiming(mDevice, mSwapchain, &timingCount, nullptr);
+    if (result != VK_SUCCESS || !timingCount) {
+        return;
+    }
+
+    mPastTimings.resize(timingCount);
+    result = mGetPastPresentationTiming(mDevice, mSwapchain, &timingCount, mPastTimings.data());
+    if (result != VK_SUCCESS && result != VK_INCOMPLETE) {
+        return;
+    }
+
+    // 주사율은 실행 중에도 바뀔 수 있으므로 새 결과가 올 때마다 다시 확인한다.
+    VkRefreshCycleDurationGOOGLE refreshCycleDuration{};
+    if (mGetRefreshCycleDuration(mDevice, mSwapchain, &refreshCycleDuration) == VK_SUCCESS &&
+        refreshCycleDuration.refreshDuration) {
+        mRefreshDuration = refreshCycleDuration.refreshDuration;
+    }
+
+    for (uint32_t i = 0; i != timingCount; ++i) {
+        const auto &timing = mPastTimings[i];
+
+        // 원하는 시각을 지정한 출력만 판단한다. 반 주기 앞당겼으므로 한 주기가 넘게 지나면 늦었다.
+        // 한 주기 더 일찍 나갈 수 있었다면 지금 간격이 프레임 시간보다 길다.
+        if (timing.desiredPresentTime) {
+            auto late = timing.actualPresentTime > timing.desiredPresentTime + mRefreshDuration;
+            auto early = timing.earliestPresentTime + mRefreshDuration <=
+                         timing.actualPresentTime;
+            account(late, early);
+        }
+
+        mLastPresentId = timing.presentID;
+        mLastActualPresentTime = timing.actualPresentTime;
+    }
+}
+
+void VkFramePacer::estimateRefreshDuration(uint64_t interval) {
+    // 지터를 줄이기 위해 지수 이동 평균을 쓴다.
+    mRefreshDuration = (mRefreshDuration * 7 + interval) / 8;
+}
+
+void VkFramePacer::account(bool late, bool early) {
+    ++mSampleCount;
+    mLateCount += late;
+    mEarlyCount += early;
+    mTotalLateCount += late;
+    if (mSampleCount != kAdjustInterval) {
+        return;
+    }
+
+    // 10% 넘게 늦으면 간격을 늘리고, 모든 프레임이 한 주기 일찍 준비됐으면 간격을 줄인다.
+    if (mLateCount * 10 > kAdjustInterval && mSwapInterval < kMaxSwapInterval) {
+        ++mSwapInterval;
+    } else if (!mLateCount && mEarlyCount == kAdjustInterval && mSwapInterval > 1) {
+        --mSwapInterval;
+    }
+
+    mSampleCount = 0;
+    mLateCount = 0;
+    mEarlyCount = 0;
+}
@@ -0,0 +1,120 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKFRAMEPACER_H
+#define PRACTICE_VULKAN_VKFRAMEPACER_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+/*!
+ * Spaces presents evenly on a whole number of refresh cycles.
+ *
+ * With VK_GOOGLE_display_timing the refresh duration comes from the driver, and each present
+ * carries a desiredPresentTime computed from the last actual present time reported back, so a
+ * frame that is ready early still waits for its slot. Without the extension the refresh
+ * duration is estimated from the intervals at which vkQueuePresentKHR returns, which FIFO
+ * throttles to vsync, and wait() sleeps before starting a frame that would come early.
+ *
+ * In both modes the number of refresh cycles per frame grows when frames keep missing their
+ * slot and shrinks when every frame was ready a cycle early, so the cadence settles on the
+ * fastest rate the frame time can sustain instead of alternating between two.
+ *
+ * With VK_KHR_present_id and VK_KHR_present_wait every present is tagged with an ID, and wait()
+ * blocks on vkWaitForPresentKHR until at most maxQueuedFrames presents are still waiting for
+ * the display. CPU work then starts as late as possible, which bounds the latency that FIFO
+ * would otherwise build up in the swapchain queue.
+ */
+class VkFramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    VkFramePacer(VkDevice device,
+                 VkSwapchainKHR swapchain,
+                 bool displayTimingEnabled,
+                 bool presentWaitEnabled,
+                 uint32_t maxQueuedFrames);
+
+    VkFramePacer(const VkFramePacer &) = delete;
+    VkFramePacer &operator=(const VkFramePacer &) = delete;
+
+    // 새 프레임을 시작하기 전에 호출한다. 큐에 쌓인 출력이 줄어들 때까지 기다리고, 피드백을
+    // 읽고, 추정 모드에서는 슬롯까지 잠든다.
+    void wait();
+    // 출력 ID와 원하는 출력 시각을 VkPresentInfoKHR의 pNext에 연결한다.
+    void chainPresentInfo(void **presentInfoNext);
+    // vkQueuePresentKHR이 반환된 직후에 호출한다.
+    void presented();
+    void report() const;
+
+    bool isDisplayTimingEnabled() const { return mDisplayTimingEnabled; }
+    bool isPresentWaitEnabled() const { return mPresentWaitEnabled; }
+    uint64_t refreshDuration() const { return mRefreshDuration; }
+    uint32_t swapInterval() const { return mSwapInterval; }
+
+private:
+    static constexpr uint64_t kDefaultRefreshDuration = 16666667;
+    static constexpr uint32_t kMaxSwapInterval = 4;
+    static constexpr uint32_t kAdjustInterval = 30;
+    static constexpr uint64_t kPresentWaitTimeout = 100000000;
+
+    void readPastTimings();
+    void estimateRefreshDuration(uint64_t interval);
+    void account(bool late, bool early);
+
+    VkDevice mDevice;
+    VkSwapchainKHR mSwapchain;
+    bool mDisplayTimingEnabled;
+    PFN_vkGetRefreshCycleDurationGOOGLE mGetRefreshCycleDuration = nullptr;
+    PFN_vkGetPastPresentationTimingGOOGLE mGetPastPresentationTiming = nullptr;
+    std::vector<VkPastPresentationTimingGOOGLE> mPastTimings;
+    VkPresentTimeGOOGLE mPresentTime{};
+    VkPresentTimesInfoGOOGLE mPresentTimesInfo{};
+    bool mPresentWaitEnabled;
+    uint32_t mMaxQueuedFrames;
+    PFN_vkWaitForPresentKHR mWaitForPresent = nullptr;
+    uint64_t mPresentIdValue = 0;
+    VkPresentIdKHR mPresentIdInfo{};
+
+    uint64_t mRefreshDuration = kDefaultRefreshDuration;
+    uint32_t mSwapInterval = 1;
+    uint64_t mPresentId = 1;
+    // Display timing: 화면에 실제로 나간 마지막 출력
+    uint64_t mLastPresentId = 0;
+    uint64_t mLastActualPresentTime = 0;
+    // 추정: vkQueuePresentKHR이 마지막으로 반환된 시각과 이번 프레임을 시작한 시각
+    Clock::time_point mLastPresentTime;
+    Clock::time_point mFrameStartTime;
+    bool mOnSchedule = false;
+
+    uint32_t mSampleCount = 0;
+    uint32_t mLateCount = 0;
+    uint32_t mEarlyCount = 0;
+    uint64_t mPresentCount = 0;
+    uint64_t mTotalLateCount = 0;
+    uint64_t mPresentWaitCount = 0;
+    uint64_t mPresentWaitTimeoutCount = 0;
+};
+
+#endif //PRACTICE_VULKAN_VKFRAMEPACER_H
@@ -0,0 +1,315 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <array>
+#include <cassert>
+
+#include "VkGpuCulling.h"
+#include "VkUtil.h"
+
+using namespace std;
+
+VkGpuCulling::VkGpuCulling(VkHostAllocator &hostAllocator,
+                           VkMemoryBudget &memoryBudget,
+                           VkDevice device,
+                           VkObjectCache &objectCache,
+                           VkPipelineCacheStore &pipelineCache,
+                           const VkShaderCode &computeShaderCode,
+                           VkBuffer objectBuffer,
+                           uint32_t objectCount,
+                           uint32_t indexCount,
+                           bool drawIndirectCountEnabled)
+        : mHostAllocator(hostAllocator),
+          mDevice(device),
+          mObjectCount(objectCount),
+          mIndexCount(indexCount) {
+    if (drawIndirectCountEnabled) {
+        // 코어 기능(drawIndirectCount)은 활성화하지 않으므로 확장 함수만 사용한다.
+        mCmdDrawIndexedIndirectCount = vkGetDeviceProc<PFN_vkCmdDrawIndexedIndirectCount>(
+                mDevice, {"vkCmdDrawIndexedIndirectCountKHR"});
+        assert(mCmdDrawIndexedIndirectCount);
+    }
+
+    // ================================================================================
+    // 1. Indirect 명령, 개수 VkBuffer 생성
+    // ================================================================================
+    mIndirectBuffer = make_unique<VkDeviceBuffer>(hostAllocator,
+                                                  memoryBudget,
+                                                  mDevice,
+                                                  sizeof(VkDrawIndexedIndirectCommand) *
+                                                  mObjectCount,
+                                                  VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                                  VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                                                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    mCountBuffer = make_unique<VkDeviceBuffer>(hostAllocator,
+                                               memoryBudget,
+                                               mDevice,
+                                               sizeof(uint32_t),
+                                               VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                               VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                                               VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    // ================================================================================
+    // 2. VkDescriptorSetLayout, VkPipelineLayout 생성
+    // ================================================================================
+    // 오브젝트 버퍼는 프레임마다 다른 영역을 읽으므로 dynamic offset으로 바인딩한다.
+    array<VkDescriptorSetLayoutBinding, 3> descriptorSetLayoutBindings;
+    for (uint32_t i = 0; i != descriptorSetLayoutBindings.size(); ++i) {
+        descriptorSetLayoutBindings[i] = {
+            .binding = i,
+            .descriptorType = i == 0 ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC
+                                     : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount = 1,
+            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
+        };
+    }
+
+    VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .bindingCount = static_cast<uint32_t>(descriptorSetLayoutBindings.size()),
+        .pBindings = descriptorSetLayoutBindings.data()
+    };
+
+    auto descriptorSetLayout = objectCache.descriptorSetLayout(descriptorSetLayoutCreateInfo);
+
+    VkPushConstantRange pushConstantRange{
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+        .offset = 0,
+        .size = sizeof(PushConstants)
+    };
+
+    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .setLayoutCount = 1,
+        .pSetLayouts = &descriptorSetLayout,
+        .pushConstantRangeCount = 1,
+        .pPushConstantRanges = &pushConstantRange
+    };
+
+    mPipelineLayout = objectCache.pipelineLayout(pipelineLayoutCreateInfo);
+
+    // ================================================================================
+    // 3. VkDescriptorSet 할당 및 갱신
+    // ================================================================================
+    // 버퍼가 바뀌지 않으므로 세트 하나를 만들어 두고 계속 사용한다.
+    array<VkDescriptorPoolSize, 2> poolSizes{
+        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1},
+        VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2}
+    };
+
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .maxSets = 1,
+        .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+        .pPoolSizes = poolSizes.data()
+    };
+
+    VK_CHECK_ERROR(vkCreateDescriptorPool(mDevice,
+                                          &descriptorPoolCreateInfo,
+                                          mHostAllocator.callbacks(VK_OBJECT_TYPE_DESCRIPTOR_POOL),
+                                          &mDescriptorPool));
+
+    VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .descriptorPool = mDescriptorPool,
+        .descriptorSetCount = 1,
+        .pSetLayouts = &descriptorSetLayout
+    };
+
+    VK_CHECK_ERROR(vkAllocateDescriptorSets(mDevice, &descriptorSetAllocateInfo, &mDescriptorSet));
+
+    array<VkDescriptorBufferInfo, 3> descriptorBufferInfos{
+        VkDescriptorBufferInfo{objectBuffer, 0, kObjectSize * mObjectCount},
+        VkDescriptorBufferInfo{mIndirectBuffer->buffer(), 0, VK_WHOLE_SIZE},
+        VkDescriptorBufferInfo{mCountBuffer->buffer(), 0, VK_WHOLE_SIZE}
+    };
+
+    array<VkWriteDescriptorSet, 3> writeDescriptorSets;
+    for (uint32_t i = 0; i != writeDescriptorSets.size(); ++i) {
+        writeDescriptorSets[i] = {
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .dstSet = mDescriptorSet,
+            .dstBinding = i,
+            .dstArrayElement = 0,
+            .descriptorCount = 1,
+            .descriptorType = descriptorSetLayoutBindings[i].descriptorType,
+            .pBufferInfo = &descriptorBufferInfos[i]
+        };
+    }
+
+    vkUpdateDescriptorSets(mDevice,
+                           static_cast<uint32_t>(writeDescriptorSets.size()),
+                           writeDescriptorSets.data(),
+                           0,
+                           nullptr);
+
+    // ================================================================================
+    // 4. Compute VkPipeline 생성
+    // ================================================================================
+    VkShaderModuleCreateInfo shaderModuleCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+        .codeSize = computeShaderCode.size,
+        .pCode = computeShaderCode.code
+    };
+
+    VkShaderModule shaderModule;
+    VK_CHECK_ERROR(vkCreateShaderModule(mDevice,
+                                        &shaderModuleCreateInfo,
+                                        mHostAllocator.callbacks(VK_OBJECT_TYPE_SHADER_MODULE),
+                                        &shaderModule));
+
+    VkComputePipelineCreateInfo computePipelineCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+        .stage = {
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .stage = VK_SHADER_STAGE_COMPUTE_BIT,
+            .module = shaderModule,
+            .pName = "main"
+        },
+        .layout = mPipelineLayout
+    };
+
+    // 공유 캐시는 워커 스레드가 병합하는 중일 수 있으므로 별도 캐시에 컴파일한 후 병합한다.
+    auto workerCache = pipelineCache.createWorkerCache();
+    VK_CHECK_ERROR(vkCreateComputePipelines(mDevice,
+                                            workerCache,
+                                            1,
+                                            &computePipelineCreateInfo,
+                                            mHostAllocator.callbacks(VK_OBJECT_TYPE_PIPELINE),
+                                            &mPipeline));
+    pipelineCache.merge(workerCache);
+
+    vkDestroyShaderModule(mDevice,
+                          shaderModule,
+                          mHostAllocator.callbacks(VK_OBJECT_TYPE_SHADER_MODULE));
+}
+
+VkGpuCulling::~VkGpuCulling() {
+    vkDestroyPipeline(mDevice, mPipeline, mHostAllocator.callbacks(VK_OBJECT_TYPE_PIPELINE));
+    vkDestroyDescriptorPool(mDevice,
+                            mDescriptorPool,
+                            mHostAllocator.callbacks(VK_OBJECT_TYPE_DESCRIPTOR_POOL));
+}
+
+void VkGpuCulling::record(VkCommandBuffer commandBuffer,
+                          const Rect &rect,
+                          uint32_t objectOffset) {
+    // ================================================================================
+    // 1. 이전 프레임의 indirect 읽기가 끝난 후 개수 초기화
+    // ================================================================================
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr);
+
+    vkCmdFillBuffer(commandBuffer, mCountBuffer->buffer(), 0, sizeof(uint32_t), 0);
+
+    VkMemoryBarrier fillMemoryBarrier{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+    };
+
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0,
+                         1,
+                         &fillMemoryBarrier,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr);
+
+    // ================================================================================
+    // 2. 컬링 및 indirect 명령 기록
+    // ================================================================================
+    PushConstants pushConstants{
+        .rect = rect,
+        .objectCount = mObjectCount,
+        .indexCount = mIndexCount,
+        .compact = isCompacted() ? 1u : 0u
+    };
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mPipeline);
+    vkCmdBindDescriptorSets(commandBuffer,
+                            VK_PIPELINE_BIND_POINT_COMPUTE,
+                            mPipelineLayout,
+                            0,
+                            1,
+                            &mDescriptorSet,
+                            1,
+                            &objectOffset);
+    vkCmdPushConstants(commandBuffer,
+                       mPipelineLayout,
+                       VK_SHADER_STAGE_COMPUTE_BIT,
+                       0,
+                       sizeof(pushConstants),
+                       &pushConstants);
+    vkCmdDispatch(commandBuffer, (mObjectCount + kWorkgroupSize - 1) / kWorkgroupSize, 1, 1);
+
+    // ================================================================================
+    // 3. Indirect 단계에서 결과를 읽을 수 있도록 배리어 기록
+    // ================================================================================
+    VkMemoryBarrier dispatchMemoryBarrier{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT
+    };
+
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                         0,
+                         1,
+                         &dispatchMemoryBarrier,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr);
+}
+
+void VkGpuCulling::draw(VkCommandBuffer commandBuffer) {
+    if (mCmdDrawIndexedIndirectCount) {
+        mCmdDrawIndexedIndirectCount(commandBuffer,
+                                     mIndirectBuffer->buffer(),
+                                     0,
+                                     mCountBuffer->buffer(),
+                                     0,
+                                     mObjectCount,
+                                     sizeof(VkDrawIndexedIndirectCommand));
+    } else {
+        vkCmdDrawIndexedIndirect(commandBuffer,
+                                 mIndirectBuffer->buffer(),
+                                 0,
+                                 mObjectCount,
+                                 sizeof(VkDrawIndexedIndirectCommand));
+    }
+}
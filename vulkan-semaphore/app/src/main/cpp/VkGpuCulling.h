@@ -0,0 +1,103 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKGPUCULLING_H
+#define PRACTICE_VULKAN_VKGPUCULLING_H
+
+#include <cstdint>
+#include <memory>
+#include <vulkan/vulkan.h>
+
+#include "VkDeviceBuffer.h"
+#include "VkHostAllocator.h"
+#include "VkMemoryBudget.h"
+#include "VkObjectCache.h"
+#include "VkPipelineCacheStore.h"
+#include "VkShaders.h"
+
+/*!
+ * Compute pass that culls objects on the GPU and writes the indirect draws for them.
+ *
+ * record() must be called outside a render pass. It clears the draw count, dispatches one
+ * invocation per object and makes the results visible to the indirect stage. draw() then
+ * issues a single vkCmdDrawIndexedIndirectCount inside the render pass, so the CPU cost no
+ * longer depends on the object count. Without VK_KHR_draw_indirect_count the commands are
+ * not compacted and culled objects get an instanceCount of 0, which keeps a single
+ * vkCmdDrawIndexedIndirect call. The object buffer is bound with a dynamic offset so each
+ * frame in flight can cull its own copy of the objects.
+ */
+class VkGpuCulling {
+public:
+    struct Rect {
+        float minX;
+        float minY;
+        float maxX;
+        float maxY;
+    };
+
+    VkGpuCulling(VkHostAllocator &hostAllocator,
+                 VkMemoryBudget &memoryBudget,
+                 VkDevice device,
+                 VkObjectCache &objectCache,
+                 VkPipelineCacheStore &pipelineCache,
+                 const VkShaderCode &computeShaderCode,
+                 VkBuffer objectBuffer,
+                 uint32_t objectCount,
+                 uint32_t indexCount,
+                 bool drawIndirectCountEnabled);
+    ~VkGpuCulling();
+
+    VkGpuCulling(const VkGpuCulling &) = delete;
+    VkGpuCulling &operator=(const VkGpuCulling &) = delete;
+
+    // objectOffset은 오브젝트 버퍼에서 이번 프레임 영역의 시작 위치이다.
+    void record(VkCommandBuffer commandBuffer, const Rect &rect, uint32_t objectOffset);
+    void draw(VkCommandBuffer commandBuffer);
+    bool isCompacted() const { return mCmdDrawIndexedIndirectCount != nullptr; }
+
+private:
+    static constexpr uint32_t kWorkgroupSize = 64;
+    // cull.comp이 읽는 오브젝트 하나의 크기 (offset.xy, scale, textureIndex)
+    static constexpr VkDeviceSize kObjectSize = 4 * sizeof(float);
+
+    struct PushConstants {
+        Rect rect;
+        uint32_t objectCount;
+        uint32_t indexCount;
+        uint32_t compact;
+    };
+
+    VkHostAllocator &mHostAllocator;
+    VkDevice mDevice;
+    uint32_t mObjectCount;
+    uint32_t mIndexCount;
+    std::unique_ptr<VkDeviceBuffer> mIndirectBuffer;
+    std::unique_ptr<VkDeviceBuffer> mCountBuffer;
+    VkDescriptorPool mDescriptorPool;
+    VkDescriptorSet mDescriptorSet;
+    VkPipelineLayout mPipelineLayout;
+    VkPipeline mPipeline;
+
+    PFN_vkCmdDrawIndexedIndirectCount mCmdDrawIndexedIndirectCount = nullptr;
+};
+
+#endif //PRACTICE_VULKAN_VKGPUCULLING_H
@@ -0,0 +1,258 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+
+#include "VkHostAllocator.h"
+#include "VkUtil.h"
+#include "AndroidOut.h"
+
+using namespace std;
+
+namespace {
+
+constexpr size_t kArenaSize = 64 * 1024;
+
+struct Arena {
+    unique_ptr<uint8_t[]> buffer;
+    size_t offset = 0;
+    size_t liveCount = 0;
+};
+
+struct alignas(alignof(max_align_t)) Header {
+    void *base;
+    size_t size;
+    Arena *arena;
+    void *domain;
+    VkSystemAllocationScope allocationScope;
+};
+
+thread_local Arena tArena;
+
+inline Header *toHeader(void *pMemory) {
+    return reinterpret_cast<Header *>(pMemory) - 1;
+}
+
+}
+
+void VkHostAllocator::Tracker::add(size_t size) {
+    auto currentSize = allocatedSize += size;
+    ++allocationCount;
+    ++totalAllocationCount;
+
+    auto peakSize = peakAllocatedSize.load(memory_order_relaxed);
+    while (currentSize > peakSize &&
+           !peakAllocatedSize.compare_exchange_weak(peakSize, currentSize, memory_order_relaxed)) {
+    }
+}
+
+void VkHostAllocator::Tracker::remove(size_t size) {
+    allocatedSize -= size;
+    --allocationCount;
+}
+
+VkHostAllocator::Statistics VkHostAllocator::Tracker::statistics() const {
+    return {
+        .allocatedSize = allocatedSize,
+        .allocationCount = allocationCount,
+        .peakAllocatedSize = peakAllocatedSize,
+        .totalAllocationCount = totalAllocationCount
+    };
+}
+
+const VkAllocationCallbacks *VkHostAllocator::callbacks(VkObjectType objectType) {
+    lock_guard<mutex> lock(mMutex);
+
+    auto &domain = mDomains[objectType];
+    if (!domain) {
+        domain = make_unique<Domain>();
+        domain->hostAllocator = this;
+        domain->objectType = objectType;
+        domain->callbacks = {
+            .pUserData = domain.get(),
+            .pfnAllocation = allocate,
+            .pfnReallocation = reallocate,
+            .pfnFree = deallocate,
+            .pfnInternalAllocation = notifyInternalAllocation,
+            .pfnInternalFree = notifyInternalFree
+        };
+    }
+
+    return &domain->callbacks;
+}
+
+VkHostAllocator::Statistics
+VkHostAllocator::scopeStatistics(VkSystemAllocationScope allocationScope) const {
+    assert(allocationScope < kScopeCount);
+    return mScopeTrackers[allocationScope].statistics();
+}
+
+VkHostAllocator::Statistics VkHostAllocator::objectTypeStatistics(VkObjectType objectType) {
+    lock_guard<mutex> lock(mMutex);
+
+    auto iter = mDomains.find(objectType);
+    return iter != mDomains.end() ? iter->second->tracker.statistics() : Statistics{};
+}
+
+void VkHostAllocator::report() {
+    aout << "Host Allocation Information ↓" << endl;
+    for (auto i = 0; i != kScopeCount; ++i) {
+        auto statistics = mScopeTrackers[i].statistics();
+        aout << " - " << setw(24) << left
+             << vkToString(static_cast<VkSystemAllocationScope>(i)) << ": "
+             << statistics.allocatedSize << " bytes in " << statistics.allocationCount
+             << " allocations (peak " << statistics.peakAllocatedSize << " bytes, "
+             << statistics.totalAllocationCount << " total)" << endl;
+    }
+
+    lock_guard<mutex> lock(mMutex);
+    for (const auto &[objectType, domain]: mDomains) {
+        auto statistics = domain->tracker.statistics();
+        aout << " - " << setw(24) << left << vkToString(objectType) << ": "
+             << statistics.allocatedSize << " bytes in " << statistics.allocationCount
+             << " allocations (peak " << statistics.peakAllocatedSize << " bytes, "
+             << statistics.totalAllocationCount << " total)" << endl;
+    }
+    aout << " - " << setw(24) << left << "Arena Allocations" << ": "
+         << mArenaAllocationCount << endl;
+}
+
+void *VkHostAllocator::allocate(void *pUserData,
+                                size_t size,
+                                size_t alignment,
+                                VkSystemAllocationScope allocationScope) {
+    if (!size) {
+        return nullptr;
+    }
+
+    auto domain = static_cast<Domain *>(pUserData);
+    alignment = max(alignment, alignof(Header));
+
+    auto blockSize = alignUp(sizeof(Header) + alignment + size, alignof(Header));
+    uint8_t *base = nullptr;
+    Arena *arena = nullptr;
+
+    // Command 범위의 할당은 명령이 끝나기 전에 해제되므로 스레드별 아레나에서 할당한다.
+    if (allocationScope == VK_SYSTEM_ALLOCATION_SCOPE_COMMAND) {
+        if (!tArena.buffer) {
+            tArena.buffer = make_unique<uint8_t[]>(kArenaSize);
+        }
+
+        if (tArena.offset + blockSize <= kArenaSize) {
+            base = tArena.buffer.get() + tArena.offset;
+            tArena.offset += blockSize;
+            ++tArena.liveCount;
+            arena = &tArena;
+            ++domain->hostAllocator->mArenaAllocationCount;
+        }
+    }
+
+    if (!base) {
+        base = static_cast<uint8_t *>(malloc(blockSize));
+        if (!base) {
+            return nullptr;
+        }
+    }
+
+    auto memory = reinterpret_cast<void *>(
+            alignUp(reinterpret_cast<uintptr_t>(base) + sizeof(Header), alignment));
+    *toHeader(memory) = {
+        .base = arena ? nullptr : base,
+        .size = size,
+        .arena = arena,
+        .domain = domain,
+        .allocationScope = allocationScope
+    };
+
+    domain->tracker.add(size);
+    domain->hostAllocator->mScopeTrackers[allocationScope].add(size);
+
+    return memory;
+}
+
+void *VkHostAllocator::reallocate(void *pUserData,
+                                  void *pOriginal,
+                                  size_t size,
+                                  size_t alignment,
+                                  VkSystemAllocationScope allocationScope) {
+    if (!pOriginal) {
+        return allocate(pUserData, size, alignment, allocationScope);
+    }
+
+    if (!size) {
+        deallocate(pUserData, pOriginal);
+        return nullptr;
+    }
+
+    auto memory = allocate(pUserData, size, alignment, allocationScope);
+    if (!memory) {
+        return nullptr;
+    }
+
+    memcpy(memory, pOriginal, min(size, toHeader(pOriginal)->size));
+    deallocate(pUserData, pOriginal);
+
+    return memory;
+}
+
+void VkHostAllocator::deallocate(void *pUserData, void *pMemory) {
+    if (!pMemory) {
+        return;
+    }
+
+    // 할당할 때 사용한 도메인에서 해제해야 통계가 맞는다.
+    auto header = toHeader(pMemory);
+    auto domain = static_cast<Domain *>(header->domain);
+    domain->tracker.remove(header->size);
+    domain->hostAllocator->mScopeTrackers[header->allocationScope].remove(header->size);
+
+    if (header->arena) {
+        if (--header->arena->liveCount == 0) {
+            header->arena->offset = 0;
+        }
+    } else {
+        ::free(header->base);
+    }
+}
+
+void VkHostAllocator::notifyInternalAllocation(void *pUserData,
+                                               size_t size,
+                                               VkInternalAllocationType allocationType,
+                                               VkSystemAllocationScope allocationScope) {
+    auto domain = static_cast<Domain *>(pUserData);
+    domain->tracker.add(size);
+    domain->hostAllocator->mScopeTrackers[allocationScope].add(size);
+}
+
+void VkHostAllocator::notifyInternalFree(void *pUserData,
+                                         size_t size,
+                                         VkInternalAllocationType allocationType,
+                                         VkSystemAllocationScope allocationScope) {
+    auto domain = static_cast<Domain *>(pUserData);
+    domain->tracker.remove(size);
+    domain->hostAllocator->mScopeTrackers[allocationScope].remove(size);
+}
@@ -0,0 +1,108 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKHOSTALLOCATOR_H
+#define PRACTICE_VULKAN_VKHOSTALLOCATOR_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vulkan/vulkan.h>
+
+/*!
+ * VkAllocationCallbacks that make driver host allocations visible.
+ *
+ * callbacks() hands out one VkAllocationCallbacks per VkObjectType so that every allocation can be
+ * attributed to both its VkSystemAllocationScope and the kind of object it was made for.
+ * Command scope allocations live only for the duration of a single Vulkan command, so they are
+ * served from a per-thread bump arena that rewinds once every allocation in it is freed.
+ * Everything else is served from the heap.
+ */
+class VkHostAllocator {
+public:
+    struct Statistics {
+        uint64_t allocatedSize;
+        uint64_t allocationCount;
+        uint64_t peakAllocatedSize;
+        uint64_t totalAllocationCount;
+    };
+
+    VkHostAllocator() = default;
+    VkHostAllocator(const VkHostAllocator &) = delete;
+    VkHostAllocator &operator=(const VkHostAllocator &) = delete;
+
+    const VkAllocationCallbacks *callbacks(VkObjectType objectType);
+    Statistics scopeStatistics(VkSystemAllocationScope allocationScope) const;
+    Statistics objectTypeStatistics(VkObjectType objectType);
+    uint64_t arenaAllocationCount() const { return mArenaAllocationCount; }
+    void report();
+
+private:
+    struct Tracker {
+        std::atomic<uint64_t> allocatedSize = 0;
+        std::atomic<uint64_t> allocationCount = 0;
+        std::atomic<uint64_t> peakAllocatedSize = 0;
+        std::atomic<uint64_t> totalAllocationCount = 0;
+
+        void add(size_t size);
+        void remove(size_t size);
+        Statistics statistics() const;
+    };
+
+    struct Domain {
+        VkHostAllocator *hostAllocator;
+        VkObjectType objectType;
+        Tracker tracker;
+        VkAllocationCallbacks callbacks;
+    };
+
+    static constexpr uint32_t kScopeCount = VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1;
+
+    static VKAPI_ATTR void *VKAPI_CALL allocate(void *pUserData,
+                                                size_t size,
+                                                size_t alignment,
+                                                VkSystemAllocationScope allocationScope);
+    static VKAPI_ATTR void *VKAPI_CALL reallocate(void *pUserData,
+                                                  void *pOriginal,
+                                                  size_t size,
+                                                  size_t alignment,
+                                                  VkSystemAllocationScope allocationScope);
+    static VKAPI_ATTR void VKAPI_CALL deallocate(void *pUserData, void *pMemory);
+    static VKAPI_ATTR void VKAPI_CALL notifyInternalAllocation(void *pUserData,
+                                                               size_t size,
+                                                               VkInternalAllocationType allocationType,
+                                                               VkSystemAllocationScope allocationScope);
+    static VKAPI_ATTR void VKAPI_CALL notifyInternalFree(void *pUserData,
+                                                         size_t size,
+                                                         VkInternalAllocationType allocationType,
+                                                         VkSystemAllocationScope allocationScope);
+
+    std::array<Tracker, kScopeCount> mScopeTrackers;
+    std::atomic<uint64_t> mArenaAllocationCount = 0;
+    std::mutex mMutex;
+    std::unordered_map<VkObjectType, std::unique_ptr<Domain>> mDomains;
+};
+
+#endif //PRACTICE_VULKAN_VKHOSTALLOCATOR_H
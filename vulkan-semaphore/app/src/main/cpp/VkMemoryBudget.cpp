@@ -0,0 +1,100 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iomanip>
+
+#include "VkMemoryBudget.h"
+#include "AndroidOut.h"
+
+using namespace std;
+
+VkMemoryBudget::VkMemoryBudget(VkPhysicalDevice physicalDevice, bool extensionEnabled)
+        : mPhysicalDevice(physicalDevice),
+          mExtensionEnabled(extensionEnabled) {
+    vkGetPhysicalDeviceMemoryProperties(mPhysicalDevice, &mMemoryProperties);
+    sample();
+}
+
+void VkMemoryBudget::sample() {
+    if (mExtensionEnabled) {
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT memoryBudgetProperties{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT
+        };
+
+        VkPhysicalDeviceMemoryProperties2 memoryProperties{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2,
+            .pNext = &memoryBudgetProperties
+        };
+
+        vkGetPhysicalDeviceMemoryProperties2(mPhysicalDevice, &memoryProperties);
+
+        for (auto i = 0; i != mMemoryProperties.memoryHeapCount; ++i) {
+            mHeapUsages[i] = memoryBudgetProperties.heapUsage[i];
+            mHeapBudgets[i] = memoryBudgetProperties.heapBudget[i];
+        }
+    } else {
+        for (auto i = 0; i != mMemoryProperties.memoryHeapCount; ++i) {
+            mHeapUsages[i] = mAllocatedSizes[i].load();
+            mHeapBudgets[i] = static_cast<VkDeviceSize>(mMemoryProperties.memoryHeaps[i].size *
+                                                        kFallbackBudgetRatio);
+        }
+    }
+
+    if (!mCallback) {
+        return;
+    }
+
+    for (auto i = 0; i != mMemoryProperties.memoryHeapCount; ++i) {
+        VkDeviceSize usage = mHeapUsages[i];
+        VkDeviceSize budget = mHeapBudgets[i];
+        if (usage > static_cast<VkDeviceSize>(budget * mThreshold)) {
+            mCallback(i, usage, budget);
+        }
+    }
+}
+
+void VkMemoryBudget::setCallback(Callback callback, float threshold) {
+    mCallback = std::move(callback);
+    mThreshold = threshold;
+}
+
+void VkMemoryBudget::onAllocate(uint32_t memoryTypeIndex, VkDeviceSize size) {
+    mAllocatedSizes[mMemoryProperties.memoryTypes[memoryTypeIndex].heapIndex] += size;
+}
+
+void VkMemoryBudget::onFree(uint32_t memoryTypeIndex, VkDeviceSize size) {
+    mAllocatedSizes[mMemoryProperties.memoryTypes[memoryTypeIndex].heapIndex] -= size;
+}
+
+void VkMemoryBudget::report() const {
+    aout << "Memory Budget Information ↓" << endl;
+    aout << setw(16) << left << " - Source: "
+         << (mExtensionEnabled ? "VK_EXT_memory_budget" : "Estimated") << endl;
+    for (auto i = 0; i != mMemoryProperties.memoryHeapCount; ++i) {
+        const auto &memoryHeap = mMemoryProperties.memoryHeaps[i];
+        aout << " - Heap " << i
+             << ((memoryHeap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) ? " (Device Local)" : "")
+             << ": " << (mHeapUsages[i] >> 20) << " / " << (mHeapBudgets[i] >> 20)
+             << " MiB used, " << (mAllocatedSizes[i] >> 20) << " MiB by this app, "
+             << (memoryHeap.size >> 20) << " MiB total" << endl;
+    }
+}
@@ -0,0 +1,72 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKMEMORYBUDGET_H
+#define PRACTICE_VULKAN_VKMEMORYBUDGET_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vulkan/vulkan.h>
+
+/*!
+ * Samples per-heap memory usage and budget once per frame.
+ *
+ * When VK_EXT_memory_budget is enabled the values come from the driver and include allocations
+ * made by other processes. Otherwise usage is the sum of allocations reported through
+ * onAllocate()/onFree() and the budget is a fixed fraction of the heap size. The callback is
+ * invoked for every heap whose usage is above the threshold so that streaming systems can evict
+ * before the driver starts paging or failing allocations.
+ */
+class VkMemoryBudget {
+public:
+    using Callback = std::function<void(uint32_t heapIndex, VkDeviceSize usage, VkDeviceSize budget)>;
+
+    VkMemoryBudget(VkPhysicalDevice physicalDevice, bool extensionEnabled);
+
+    void sample();
+    void setCallback(Callback callback, float threshold = 0.9f);
+    void onAllocate(uint32_t memoryTypeIndex, VkDeviceSize size);
+    void onFree(uint32_t memoryTypeIndex, VkDeviceSize size);
+    void report() const;
+
+    const VkPhysicalDeviceMemoryProperties &memoryProperties() const { return mMemoryProperties; }
+    uint32_t heapCount() const { return mMemoryProperties.memoryHeapCount; }
+    VkDeviceSize usage(uint32_t heapIndex) const { return mHeapUsages[heapIndex]; }
+    VkDeviceSize budget(uint32_t heapIndex) const { return mHeapBudgets[heapIndex]; }
+    VkDeviceSize allocatedSize(uint32_t heapIndex) const { return mAllocatedSizes[heapIndex]; }
+
+private:
+    static constexpr float kFallbackBudgetRatio = 0.8f;
+
+    VkPhysicalDevice mPhysicalDevice;
+    bool mExtensionEnabled;
+    VkPhysicalDeviceMemoryProperties mMemoryProperties;
+    std::array<std::atomic<VkDeviceSize>, VK_MAX_MEMORY_HEAPS> mHeapUsages{};
+    std::array<std::atomic<VkDeviceSize>, VK_MAX_MEMORY_HEAPS> mHeapBudgets{};
+    std::array<std::atomic<VkDeviceSize>, VK_MAX_MEMORY_HEAPS> mAllocatedSizes{};
+    Callback mCallback;
+    float mThreshold = 0.9f;
+};
+
+#endif //PRACTICE_VULKAN_VKMEMORYBUDGET_H
@@ -0,0 +1,290 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstddef>
+#include <iomanip>
+
+#include "VkObjectCache.h"
+#include "Hash.h"
+#include "VkUtil.h"
+#include "AndroidOut.h"
+
+using namespace std;
+
+namespace {
+
+/*!
+ * Flattens create infos into bytes. Only members are written, never padding or pointers, so
+ * equal create infos always produce equal keys.
+ */
+class KeyWriter {
+public:
+    template<typename T>
+    void write(const T &value) {
+        append(&value, sizeof(T));
+    }
+
+    // 배열은 개수와 함께 기록하고 null 포인터는 빈 배열과 구분한다.
+    template<typename T>
+    void write(const T *values, uint32_t count) {
+        write(count);
+        write<uint8_t>(values != nullptr);
+        if (values) {
+            append(values, sizeof(T) * count);
+        }
+    }
+
+    // 구조체에서 first부터 last까지의 멤버를 기록한다. 사이에 패딩이 없어야 한다.
+    template<typename T, typename U>
+    void writeRange(const T *first, const U *last) {
+        auto begin = reinterpret_cast<const uint8_t *>(first);
+        auto end = reinterpret_cast<const uint8_t *>(last) + sizeof(U);
+        append(begin, end - begin);
+    }
+
+    bool writeNext(const void *next);
+
+    vector<uint8_t> bytes;
+
+private:
+    void append(const void *data, size_t size) {
+        auto begin = static_cast<const uint8_t *>(data);
+        bytes.insert(bytes.end(), begin, begin + size);
+    }
+};
+
+bool KeyWriter::writeNext(const void *next) {
+    for (auto header = static_cast<const VkBaseInStructure *>(next);
+         header;
+         header = header->pNext) {
+        write(header->sType);
+        switch (header->sType) {
+            case VK_STRUCTURE_TYPE_SAMPLER_REDUCTION_MODE_CREATE_INFO: {
+                auto info = reinterpret_cast<const VkSamplerReductionModeCreateInfo *>(header);
+                write(info->reductionMode);
+                break;
+            }
+            case VK_STRUCTURE_TYPE_SAMPLER_YCBCR_CONVERSION_INFO: {
+                auto info = reinterpret_cast<const VkSamplerYcbcrConversionInfo *>(header);
+                write(info->conversion);
+                break;
+            }
+            case VK_STRUCTURE_TYPE_SAMPLER_CUSTOM_BORDER_COLOR_CREATE_INFO_EXT: {
+                auto info =
+                        reinterpret_cast<const VkSamplerCustomBorderColorCreateInfoEXT *>(header);
+                write(info->customBorderColor);
+                write(info->format);
+                break;
+            }
+            case VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO: {
+                auto info =
+                        reinterpret_cast<const VkDescriptorSetLayoutBindingFlagsCreateInfo *>(
+                                header);
+                write(info->pBindingFlags, info->bindingCount);
+                break;
+            }
+            case VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO: {
+                auto info = reinterpret_cast<const VkRenderPassMultiviewCreateInfo *>(header);
+                write(info->pViewMasks, info->subpassCount);
+                write(info->pViewOffsets, info->dependencyCount);
+                write(info->pCorrelationMasks, info->correlationMaskCount);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+}
+
+VkObjectCache::VkObjectCache(VkHostAllocator &hostAllocator,
+                             VkDevice device,
+                             const VkPhysicalDeviceLimits &limits)
+        : mHostAllocator(hostAllocator),
+          mDevice(device),
+          mMaxSamplerAllocationCount(limits.maxSamplerAllocationCount) {
+}
+
+VkObjectCache::~VkObjectCache() {
+    destroy(mSamplers, [this](VkSampler sampler) {
+        vkDestroySampler(mDevice, sampler, mHostAllocator.callbacks(VK_OBJECT_TYPE_SAMPLER));
+    });
+    destroy(mDescriptorSetLayouts, [this](VkDescriptorSetLayout descriptorSetLayout) {
+        vkDestroyDescriptorSetLayout(
+                mDevice,
+                descriptorSetLayout,
+                mHostAllocator.callbacks(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT));
+    });
+    destroy(mPipelineLayouts, [this](VkPipelineLayout pipelineLayout) {
+        vkDestroyPipelineLayout(mDevice,
+                                pipelineLayout,
+                                mHostAllocator.callbacks(VK_OBJECT_TYPE_PIPELINE_LAYOUT));
+    });
+    destroy(mRenderPasses, [this](VkRenderPass renderPass) {
+        vkDestroyRenderPass(mDevice,
+                            renderPass,
+                            mHostAllocator.callbacks(VK_OBJECT_TYPE_RENDER_PASS));
+    });
+}
+
+VkSampler VkObjectCache::sampler(const VkSamplerCreateInfo &createInfo) {
+    KeyWriter key;
+    key.writeRange(&createInfo.flags, &createInfo.unnormalizedCoordinates);
+    auto cacheable = key.writeNext(createInfo.pNext);
+
+    return find(mSamplers, cacheable ? &key.bytes : nullptr, [&]() {
+        VkSampler sampler;
+        VK_CHECK_ERROR(vkCreateSampler(mDevice,
+                                       &createInfo,
+                                       mHostAllocator.callbacks(VK_OBJECT_TYPE_SAMPLER),
+                                       &sampler));
+        return sampler;
+    });
+}
+
+VkDescriptorSetLayout
+VkObjectCache::descriptorSetLayout(const VkDescriptorSetLayoutCreateInfo &createInfo) {
+    KeyWriter key;
+    key.write(createInfo.flags);
+    key.write(createInfo.bindingCount);
+    for (uint32_t i = 0; i != createInfo.bindingCount; ++i) {
+        const auto &binding = createInfo.pBindings[i];
+        key.writeRange(&binding.binding, &binding.stageFlags);
+        key.write(binding.pImmutableSamplers, binding.descriptorCount);
+    }
+    auto cacheable = key.writeNext(createInfo.pNext);
+
+    return find(mDescriptorSetLayouts, cacheable ? &key.bytes : nullptr, [&]() {
+        VkDescriptorSetLayout descriptorSetLayout;
+        VK_CHECK_ERROR(vkCreateDescriptorSetLayout(
+                mDevice,
+                &createInfo,
+                mHostAllocator.callbacks(VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT),
+                &descriptorSetLayout));
+        return descriptorSetLayout;
+    });
+}
+
+VkPipelineLayout VkObjectCache::pipelineLayout(const VkPipelineLayoutCreateInfo &createInfo) {
+    KeyWriter key;
+    key.write(createInfo.flags);
+    key.write(createInfo.pSetLayouts, createInfo.setLayoutCount);
+    key.write(createInfo.pPushConstantRanges, createInfo.pushConstantRangeCount);
+    auto cacheable = key.writeNext(createInfo.pNext);
+
+    return find(mPipelineLayouts, cacheable ? &key.bytes : nullptr, [&]() {
+        VkPipelineLayout pipelineLayout;
+        VK_CHECK_ERROR(vkCreatePipelineLayout(
+                mDevice,
+                &createInfo,
+                mHostAllocator.callbacks(VK_OBJECT_TYPE_PIPELINE_LAYOUT),
+                &pipelineLayout));
+        return pipelineLayout;
+    });
+}
+
+VkRenderPass VkObjectCache::renderPass(const VkRenderPassCreateInfo &createInfo) {
+    KeyWriter key;
+    key.write(createInfo.flags);
+    key.write(createInfo.pAttachments, createInfo.attachmentCount);
+    key.write(createInfo.subpassCount);
+    for (uint32_t i = 0; i != createInfo.subpassCount; ++i) {
+        const auto &subpass = createInfo.pSubpasses[i];
+        key.write(subpass.flags);
+        key.write(subpass.pipelineBindPoint);
+        key.write(subpass.pInputAttachments, subpass.inputAttachmentCount);
+        key.write(subpass.pColorAttachments, subpass.colorAttachmentCount);
+        key.write(subpass.pResolveAttachments, subpass.colorAttachmentCount);
+        key.write(subpass.pDepthStencilAttachment, 1);
+        key.write(subpass.pPreserveAttachments, subpass.preserveAttachmentCount);
+    }
+    key.write(createInfo.pDependencies, createInfo.dependencyCount);
+    auto cacheable = key.writeNext(createInfo.pNext);
+
+    return find(mRenderPasses, cacheable ? &key.bytes : nullptr, [&]() {
+        VkRenderPass renderPass;
+        VK_CHECK_ERROR(vkCreateRenderPass(mDevice,
+                                          &createInfo,
+                                          mHostAllocator.callbacks(VK_OBJECT_TYPE_RENDER_PASS),
+                                          &renderPass));
+        return renderPass;
+    });
+}
+
+void VkObjectCache::report() {
+    aout << "Object Cache Information ↓" << endl;
+    report("Sampler", mSamplers);
+    report("Set Layout", mDescriptorSetLayouts);
+    report("Pipe Layout", mPipelineLayouts);
+    report("Render Pass", mRenderPasses);
+    aout << setw(16) << left << " - Sampler Limit: " << mMaxSamplerAllocationCount << endl;
+}
+
+template<typename T, typename Create>
+T VkObjectCache::find(Cache<T> &cache, const vector<uint8_t> *key, Create create) {
+    if (!key) {
+        auto object = create();
+        lock_guard<mutex> lock(cache.mutex);
+        cache.uncachedObjects.push_back(object);
+        ++cache.missCount;
+        return object;
+    }
+
+    auto hash = hashCombine(kHashSeed, *key);
+
+    lock_guard<mutex> lock(cache.mutex);
+    auto [first, last] = cache.objects.equal_range(hash);
+    for (auto iter = first; iter != last; ++iter) {
+        if (iter->second.first == *key) {
+            ++cache.hitCount;
+            return iter->second.second;
+        }
+    }
+
+    // 같은 객체가 두 번 생성되지 않도록 잠금을 유지한 채로 생성한다.
+    auto object = create();
+    cache.objects.emplace(hash, make_pair(*key, object));
+    ++cache.missCount;
+
+    return object;
+}
+
+template<typename T, typename Destroy>
+void VkObjectCache::destroy(Cache<T> &cache, Destroy destroy) {
+    for (auto &[hash, object] : cache.objects) {
+        destroy(object.second);
+    }
+
+    for (auto object : cache.uncachedObjects) {
+        destroy(object);
+    }
+}
+
+template<typename T>
+void VkObjectCache::report(const char *name, Cache<T> &cache) {
+    aout << " - " << setw(13) << left << name << ": "
+         << cache.objects.size() + cache.uncachedObjects.size() << " objects, "
+         << cache.hitCount << " hits, " << cache.missCount << " misses" << endl;
+}
@@ -0,0 +1,90 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKOBJECTCACHE_H
+#define PRACTICE_VULKAN_VKOBJECTCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "VkHostAllocator.h"
+
+/*!
+ * Content addressed cache of immutable Vulkan objects.
+ *
+ * Each create info, including the arrays it points to and its pNext chain, is flattened into
+ * a byte key. Identical create infos return the same handle, which the cache owns until it is
+ * destroyed. Create infos whose pNext chain contains a structure the cache does not know are
+ * created directly and never shared, so an unknown extension can't alias two different
+ * objects.
+ */
+class VkObjectCache {
+public:
+    VkObjectCache(VkHostAllocator &hostAllocator,
+                  VkDevice device,
+                  const VkPhysicalDeviceLimits &limits);
+    ~VkObjectCache();
+
+    VkObjectCache(const VkObjectCache &) = delete;
+    VkObjectCache &operator=(const VkObjectCache &) = delete;
+
+    VkSampler sampler(const VkSamplerCreateInfo &createInfo);
+    VkDescriptorSetLayout descriptorSetLayout(const VkDescriptorSetLayoutCreateInfo &createInfo);
+    VkPipelineLayout pipelineLayout(const VkPipelineLayoutCreateInfo &createInfo);
+    VkRenderPass renderPass(const VkRenderPassCreateInfo &createInfo);
+    void report();
+
+private:
+    template<typename T>
+    struct Cache {
+        std::mutex mutex;
+        std::unordered_multimap<uint64_t, std::pair<std::vector<uint8_t>, T>> objects;
+        // pNext 체인을 해석할 수 없어서 캐시하지 못한 객체들
+        std::vector<T> uncachedObjects;
+        std::atomic<uint32_t> hitCount = 0;
+        std::atomic<uint32_t> missCount = 0;
+    };
+
+    template<typename T, typename Create>
+    T find(Cache<T> &cache, const std::vector<uint8_t> *key, Create create);
+
+    template<typename T, typename Destroy>
+    void destroy(Cache<T> &cache, Destroy destroy);
+
+    template<typename T>
+    void report(const char *name, Cache<T> &cache);
+
+    VkHostAllocator &mHostAllocator;
+    VkDevice mDevice;
+    uint32_t mMaxSamplerAllocationCount;
+    Cache<VkSampler> mSamplers;
+    Cache<VkDescriptorSetLayout> mDescriptorSetLayouts;
+    Cache<VkPipelineLayout> mPipelineLayouts;
+    Cache<VkRenderPass> mRenderPasses;
+};
+
+#endif //PRACTICE_VULKAN_VKOBJECTCACHE_H
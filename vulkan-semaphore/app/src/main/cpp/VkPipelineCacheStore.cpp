@@ -0,0 +1,216 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+#include "VkPipelineCacheStore.h"
+#include "VkUtil.h"
+#include "AndroidOut.h"
+
+using namespace std;
+
+VkPipelineCacheStore::VkPipelineCacheStore(VkHostAllocator &hostAllocator,
+                                           VkDevice device,
+                                           const VkPhysicalDeviceProperties &properties,
+                                           string path)
+        : mHostAllocator(hostAllocator),
+          mDevice(device),
+          mPhysicalDeviceProperties(properties),
+          mPath(std::move(path)) {
+    // ================================================================================
+    // 1. 저장된 캐시 데이터 읽기 및 검증
+    // ================================================================================
+    auto initialData = read();
+    if (!validate(initialData)) {
+        initialData.clear();
+    }
+    mSavedSize = initialData.size();
+
+    // ================================================================================
+    // 2. VkPipelineCache 생성
+    // ================================================================================
+    VkPipelineCacheCreateInfo pipelineCacheCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .initialDataSize = initialData.size(),
+        .pInitialData = initialData.data()
+    };
+
+    VK_CHECK_ERROR(vkCreatePipelineCache(mDevice,
+                                         &pipelineCacheCreateInfo,
+                                         mHostAllocator.callbacks(VK_OBJECT_TYPE_PIPELINE_CACHE),
+                                         &mCache));
+
+    aout << "Pipeline Cache Information ↓" << endl;
+    aout << setw(16) << left << " - Path: " << mPath << endl;
+    aout << setw(16) << left << " - Loaded: " << initialData.size() << " bytes" << endl;
+}
+
+VkPipelineCacheStore::~VkPipelineCacheStore() {
+    {
+        lock_guard<mutex> lock(mSaveMutex);
+        if (mSaveFuture.valid()) {
+            mSaveFuture.wait();
+        }
+    }
+
+    // 마지막 저장 이후에 늘어난 데이터가 있으면 종료 전에 기록한다.
+    aout << "Pipeline Cache Information ↓" << endl;
+    auto cacheData = data();
+    if (cacheData.size() != mSavedSize) {
+        if (write(cacheData)) {
+            mSavedSize = cacheData.size();
+        } else {
+            aout << "Failed to write the pipeline cache." << endl;
+        }
+    }
+    aout << setw(16) << left << " - Saved: " << mSavedSize << " bytes" << endl;
+
+    vkDestroyPipelineCache(mDevice,
+                           mCache,
+                           mHostAllocator.callbacks(VK_OBJECT_TYPE_PIPELINE_CACHE));
+}
+
+VkPipelineCache VkPipelineCacheStore::createWorkerCache() {
+    VkPipelineCacheCreateInfo pipelineCacheCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO
+    };
+
+    VkPipelineCache workerCache;
+    VK_CHECK_ERROR(vkCreatePipelineCache(mDevice,
+                                         &pipelineCacheCreateInfo,
+                                         mHostAllocator.callbacks(VK_OBJECT_TYPE_PIPELINE_CACHE),
+                                         &workerCache));
+
+    return workerCache;
+}
+
+void VkPipelineCacheStore::merge(VkPipelineCache workerCache) {
+    {
+        // dstCache는 외부 동기화가 필요하다.
+        lock_guard<mutex> lock(mMutex);
+        VK_CHECK_ERROR(vkMergePipelineCaches(mDevice, mCache, 1, &workerCache));
+    }
+
+    vkDestroyPipelineCache(mDevice,
+                           workerCache,
+                           mHostAllocator.callbacks(VK_OBJECT_TYPE_PIPELINE_CACHE));
+}
+
+void VkPipelineCacheStore::saveAsync() {
+    lock_guard<mutex> lock(mSaveMutex);
+
+    // 이전 저장이 아직 진행 중이면 다음 기회에 저장한다.
+    if (mSaveFuture.valid() &&
+        mSaveFuture.wait_for(chrono::seconds(0)) != future_status::ready) {
+        return;
+    }
+
+    mSaveFuture = async(launch::async, [this]() {
+        auto cacheData = data();
+        if (cacheData.size() == mSavedSize) {
+            return;
+        }
+
+        // 백그라운드 스레드에서는 로그를 남기지 않고 결과만 기록한다.
+        if (write(cacheData)) {
+            mSavedSize = cacheData.size();
+        }
+    });
+}
+
+bool VkPipelineCacheStore::validate(const vector<uint8_t> &data) const {
+    if (data.empty()) {
+        return false;
+    }
+
+    VkPipelineCacheHeaderVersionOne header;
+    if (data.size() < sizeof(header)) {
+        aout << "Pipeline cache is discarded: truncated header." << endl;
+        return false;
+    }
+    memcpy(&header, data.data(), sizeof(header));
+
+    if (header.headerSize < sizeof(header) ||
+        header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
+        aout << "Pipeline cache is discarded: unknown header version." << endl;
+        return false;
+    }
+
+    // 드라이버가 업데이트되거나 다른 GPU의 캐시라면 사용할 수 없다.
+    if (header.vendorID != mPhysicalDeviceProperties.vendorID ||
+        header.deviceID != mPhysicalDeviceProperties.deviceID ||
+        memcmp(header.pipelineCacheUUID,
+               mPhysicalDeviceProperties.pipelineCacheUUID,
+               VK_UUID_SIZE)) {
+        aout << "Pipeline cache is discarded: device or driver mismatch." << endl;
+        return false;
+    }
+
+    return true;
+}
+
+vector<uint8_t> VkPipelineCacheStore::read() const {
+    ifstream file(mPath, ios::binary | ios::ate);
+    if (!file) {
+        return {};
+    }
+
+    vector<uint8_t> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char *>(data.data()), static_cast<streamsize>(data.size()))) {
+        return {};
+    }
+
+    return data;
+}
+
+bool VkPipelineCacheStore::write(const vector<uint8_t> &data) const {
+    // 기록 도중 종료되어도 이전 파일이 깨지지 않도록 임시 파일에 쓴 후 교체한다.
+    // 디스크가 가득 차면 flush나 close에서 실패하므로 닫은 뒤에 결과를 확인한다.
+    auto temporaryPath = mPath + ".tmp";
+    ofstream file(temporaryPath, ios::binary | ios::trunc);
+    file.write(reinterpret_cast<const char *>(data.data()), static_cast<streamsize>(data.size()));
+    file.close();
+    if (!file || rename(temporaryPath.c_str(), mPath.c_str())) {
+        remove(temporaryPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+vector<uint8_t> VkPipelineCacheStore::data() {
+    lock_guard<mutex> lock(mMutex);
+
+    size_t dataSize;
+    VK_CHECK_ERROR(vkGetPipelineCacheData(mDevice, mCache, &dataSize, nullptr));
+
+    vector<uint8_t> data(dataSize);
+    VK_CHECK_ERROR(vkGetPipelineCacheData(mDevice, mCache, &dataSize, data.data()));
+    data.resize(dataSize);
+
+    return data;
+}
@@ -0,0 +1,74 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKPIPELINECACHESTORE_H
+#define PRACTICE_VULKAN_VKPIPELINECACHESTORE_H
+
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "VkHostAllocator.h"
+
+/*!
+ * VkPipelineCache persisted in app storage.
+ *
+ * The file is only used as initial data when its header matches the running driver. Worker
+ * threads compile into their own caches and merge them back, and the data is written to disk
+ * on a background thread so that rendering never waits for file I/O.
+ */
+class VkPipelineCacheStore {
+public:
+    VkPipelineCacheStore(VkHostAllocator &hostAllocator,
+                         VkDevice device,
+                         const VkPhysicalDeviceProperties &properties,
+                         std::string path);
+    ~VkPipelineCacheStore();
+
+    VkPipelineCacheStore(const VkPipelineCacheStore &) = delete;
+    VkPipelineCacheStore &operator=(const VkPipelineCacheStore &) = delete;
+
+    VkPipelineCache cache() const { return mCache; }
+    VkPipelineCache createWorkerCache();
+    void merge(VkPipelineCache workerCache);
+    void saveAsync();
+
+private:
+    bool validate(const std::vector<uint8_t> &data) const;
+    std::vector<uint8_t> read() const;
+    bool write(const std::vector<uint8_t> &data) const;
+    std::vector<uint8_t> data();
+
+    VkHostAllocator &mHostAllocator;
+    VkDevice mDevice;
+    VkPhysicalDeviceProperties mPhysicalDeviceProperties;
+    std::string mPath;
+    VkPipelineCache mCache;
+    std::mutex mMutex;
+    std::mutex mSaveMutex;
+    std::future<void> mSaveFuture;
+    size_t mSavedSize = 0;
+};
+
+#endif //PRACTICE_VULKAN_VKPIPELINECACHESTORE_H
@@ -0,0 +1,537 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cassert>
+#include <chrono>
+#include <iomanip>
+
+#include "VkPipelineManager.h"
+#include "Hash.h"
+#include "VkUtil.h"
+#include "AndroidOut.h"
+
+using namespace std;
+
+namespace {
+
+/*!
+ * Every create info a graphics pipeline needs, built from a VkGraphicsPipelineState.
+ *
+ * The structures point at each other, so this is neither copyable nor movable.
+ */
+struct PipelineCreateInfos {
+    explicit PipelineCreateInfos(const VkGraphicsPipelineState &state);
+    PipelineCreateInfos(const PipelineCreateInfos &) = delete;
+    PipelineCreateInfos &operator=(const PipelineCreateInfos &) = delete;
+
+    VkSpecializationInfo specializationInfo;
+    array<VkPipelineShaderStageCreateInfo, 2> shaderStageCreateInfos;
+    VkPipelineVertexInputStateCreateInfo vertexInputStateCreateInfo;
+    VkPipelineInputAssemblyStateCreateInfo inputAssemblyStateCreateInfo;
+    VkPipelineViewportStateCreateInfo viewportStateCreateInfo;
+    VkPipelineRasterizationStateCreateInfo rasterizationStateCreateInfo;
+    VkPipelineMultisampleStateCreateInfo multisampleStateCreateInfo;
+    VkPipelineDepthStencilStateCreateInfo depthStencilStateCreateInfo;
+    VkPipelineColorBlendAttachmentState colorBlendAttachmentState;
+    VkPipelineColorBlendStateCreateInfo colorBlendStateCreateInfo;
+    array<VkDynamicState, 2> dynamicStates;
+    VkPipelineDynamicStateCreateInfo dynamicStateCreateInfo;
+    VkPipelineRenderingCreateInfo renderingCreateInfo;
+};
+
+PipelineCreateInfos::PipelineCreateInfos(const VkGraphicsPipelineState &state) {
+    specializationInfo = {
+        .mapEntryCount = static_cast<uint32_t>(state.specializationMapEntries.size()),
+        .pMapEntries = state.specializationMapEntries.data(),
+        .dataSize = state.specializationData.size(),
+        .pData = state.specializationData.data()
+    };
+
+    auto specialized = !state.specializationMapEntries.empty();
+    shaderStageCreateInfos = {
+        VkPipelineShaderStageCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .stage = VK_SHADER_STAGE_VERTEX_BIT,
+            .module = state.vertexShaderModule,
+            .pName = "main",
+            .pSpecializationInfo = specialized ? &specializationInfo : nullptr
+        },
+        VkPipelineShaderStageCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .stage = VK_SHADER_STAGE_FRAGMENT_BIT,
+            .module = state.fragmentShaderModule,
+            .pName = "main",
+            .pSpecializationInfo = specialized ? &specializationInfo : nullptr
+        }
+    };
+
+    vertexInputStateCreateInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+        .vertexBindingDescriptionCount =
+                static_cast<uint32_t>(state.vertexBindingDescriptions.size()),
+        .pVertexBindingDescriptions = state.vertexBindingDescriptions.data(),
+        .vertexAttributeDescriptionCount =
+                static_cast<uint32_t>(state.vertexAttributeDescriptions.size()),
+        .pVertexAttributeDescriptions = state.vertexAttributeDescriptions.data()
+    };
+
+    inputAssemblyStateCreateInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+        .topology = state.topology
+    };
+
+    // Viewport와 scissor는 dynamic state로 설정한다.
+    viewportStateCreateInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+        .viewportCount = 1,
+        .scissorCount = 1
+    };
+
+    rasterizationStateCreateInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+        .polygonMode = VK_POLYGON_MODE_FILL,
+        .cullMode = state.cullMode,
+        .frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE,
+        .lineWidth = 1.0f
+    };
+
+    multisampleStateCreateInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+        .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT
+    };
+
+    depthStencilStateCreateInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
+        .depthTestEnable = state.depthTestEnable,
+        .depthWriteEnable = state.depthWriteEnable,
+        .depthCompareOp = state.depthCompareOp
+    };
+
+    colorBlendAttachmentState = {
+        .blendEnable = VK_FALSE,
+        .colorWriteMask = VK_COLOR_COMPONENT_R_BIT |
+                          VK_COLOR_COMPONENT_G_BIT |
+                          VK_COLOR_COMPONENT_B_BIT |
+                          VK_COLOR_COMPONENT_A_BIT
+    };
+
+    colorBlendStateCreateInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+        .attachmentCount = 1,
+        .pAttachments = &colorBlendAttachmentState
+    };
+
+    dynamicStates = {
+        VK_DYNAMIC_STATE_VIEWPORT,
+        VK_DYNAMIC_STATE_SCISSOR
+    };
+
+    dynamicStateCreateInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+        .dynamicStateCount = static_cast<uint32_t>(dynamicStates.size()),
+        .pDynamicStates = dynamicStates.data()
+    };
+
+    renderingCreateInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+        .colorAttachmentCount = 1,
+        .pColorAttachmentFormats = &state.colorFormat,
+        .depthAttachmentFormat = state.depthFormat,
+        .stencilAttachmentFormat = state.stencilFormat
+    };
+}
+
+// 라이브러리 키에 값을 바이트로 덧붙인다. 배열은 개수와 함께 기록해서 경계를 구분한다.
+template<typename T>
+void appendKey(vector<uint8_t> *key, const T &value) {
+    auto bytes = reinterpret_cast<const uint8_t *>(&value);
+    key->insert(key->end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+void appendKey(vector<uint8_t> *key, const vector<T> &values) {
+    appendKey(key, static_cast<uint32_t>(values.size()));
+    auto bytes = reinterpret_cast<const uint8_t *>(values.data());
+    key->insert(key->end(), bytes, bytes + values.size() * sizeof(T));
+}
+
+}
+
+VkPipelineManager::VkPipelineManager(VkHostAllocator &hostAllocator,
+                                     VkDevice device,
+                                     VkPipelineCacheStore &pipelineCache,
+                                     JobSystem &jobSystem,
+                                     bool graphicsPipelineLibraryEnabled)
+        : mHostAllocator(hostAllocator),
+          mDevice(device),
+          mPipelineCache(pipelineCache),
+          mJobSystem(jobSystem),
+          mGraphicsPipelineLibraryEnabled(graphicsPipelineLibraryEnabled),
+          mEntries(make_unique<Entry[]>(kMaxPipelineCount)) {
+}
+
+VkPipelineManager::~VkPipelineManager() {
+    // 컴파일 중인 작업이 끝나야 파이프라인을 파괴할 수 있다.
+    mJobSystem.wait();
+
+    auto allocationCallbacks = mHostAllocator.callbacks(VK_OBJECT_TYPE_PIPELINE);
+    for (uint32_t i = 0; i != mEntryCount; ++i) {
+        vkDestroyPipeline(mDevice, mEntries[i].pipeline, allocationCallbacks);
+        vkDestroyPipeline(mDevice, mEntries[i].retiredPipeline, allocationCallbacks);
+    }
+
+    for (auto &libraries : mLibraries) {
+        for (auto &[hash, library] : libraries) {
+            vkDestroyPipeline(mDevice, library.second, allocationCallbacks);
+        }
+    }
+}
+
+VkPipelineManager::Handle VkPipelineManager::request(VkGraphicsPipelineState state) {
+    // 배열이 가득 차면 개수를 늘리지 않고 거절해서 배열 밖에 쓰지 않게 한다.
+    auto handle = mEntryCount.load();
+    do {
+        if (handle == kMaxPipelineCount) {
+            ++mRejectedCount;
+            return kInvalidHandle;
+        }
+    } while (!mEntryCount.compare_exchange_weak(handle, handle + 1));
+
+    auto entry = &mEntries[handle];
+    entry->state = std::move(state);
+
+    ++mPendingCount;
+    mJobSystem.submit([this, entry]() { compile(*entry); });
+
+    return handle;
+}
+
+void VkPipelineManager::report() const {
+    aout << "Pipeline Manager Information ↓" << endl;
+    aout << setw(16) << left << " - Mode: "
+         << (mGraphicsPipelineLibraryEnabled ? "Pipeline Library" : "Monolithic") << endl;
+    aout << setw(16) << left << " - Compiled: " << mCompileCount << endl;
+    aout << setw(16) << left << " - Pending: " << mPendingCount << endl;
+    aout << setw(16) << left << " - Rejected: " << mRejectedCount << endl;
+    if (mCompileCount) {
+        aout << fixed << setprecision(3);
+        if (mGraphicsPipelineLibraryEnabled) {
+            aout << setw(16) << left << " - Fast Link: "
+                 << mFastLinkTime / 1000.0 / mCompileCount << " ms" << endl;
+        }
+        aout << setw(16) << left << " - Average: "
+             << mCompileTime / 1000.0 / mCompileCount << " ms" << endl;
+        aout << defaultfloat;
+    }
+    if (mGraphicsPipelineLibraryEnabled) {
+        aout << setw(16) << left << " - Library Hit: " << mLibraryHitCount << endl;
+        aout << setw(16) << left << " - Library Miss: " << mLibraryMissCount << endl;
+    }
+}
+
+VkPipeline VkPipelineManager::pipeline(Handle handle) const {
+    if (handle == kInvalidHandle) {
+        return VK_NULL_HANDLE;
+    }
+
+    assert(handle < mEntryCount);
+    return mEntries[handle].pipeline.load(memory_order_acquire);
+}
+
+void VkPipelineManager::wait(Handle handle) {
+    if (handle == kInvalidHandle) {
+        return;
+    }
+
+    assert(handle < mEntryCount);
+    auto entry = &mEntries[handle];
+
+    unique_lock<mutex> lock(mMutex);
+    mReadyCondition.wait(lock, [entry]() { return entry->ready.load(); });
+}
+
+void VkPipelineManager::compile(Entry &entry) {
+    auto &state = entry.state;
+    auto beginTime = chrono::steady_clock::now();
+    auto workerCache = mPipelineCache.createWorkerCache();
+
+    if (mGraphicsPipelineLibraryEnabled) {
+        // ================================================================================
+        // 1. 파이프라인 라이브러리 준비
+        // ================================================================================
+        array<VkPipeline, kLibraryPartCount> libraries;
+        for (auto part = 0; part != kLibraryPartCount; ++part) {
+            libraries[part] = library(static_cast<LibraryPart>(part), state, workerCache);
+        }
+
+        // ================================================================================
+        // 2. 빠른 링크 후 바로 렌더 스레드에 공개
+        // ================================================================================
+        publish(entry, linkLibraries(libraries, state, workerCache, false));
+
+        auto fastLinkTime = chrono::steady_clock::now() - beginTime;
+        mFastLinkTime += chrono::duration_cast<chrono::microseconds>(fastLinkTime).count();
+
+        // ================================================================================
+        // 3. 링크 타임 최적화 후 교체
+        // ================================================================================
+        auto optimizedPipeline = linkLibraries(libraries, state, workerCache, true);
+        entry.retiredPipeline = entry.pipeline.exchange(optimizedPipeline, memory_order_acq_rel);
+    } else {
+        publish(entry, createMonolithicPipeline(state, workerCache));
+    }
+
+    mPipelineCache.merge(workerCache);
+
+    auto compileTime = chrono::steady_clock::now() - beginTime;
+    mCompileTime += chrono::duration_cast<chrono::microseconds>(compileTime).count();
+    ++mCompileCount;
+
+    // 모든 컴파일이 끝나면 합쳐진 캐시를 디스크에 기록한다.
+    if (--mPendingCount == 0) {
+        mPipelineCache.saveAsync();
+    }
+}
+
+VkPipeline VkPipelineManager::createMonolithicPipeline(const VkGraphicsPipelineState &state,
+                                                       VkPipelineCache pipelineCache) {
+    PipelineCreateInfos createInfos(state);
+
+    VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = state.renderPass == VK_NULL_HANDLE ? &createInfos.renderingCreateInfo : nullptr,
+        .flags = state.flags,
+        .stageCount = static_cast<uint32_t>(createInfos.shaderStageCreateInfos.size()),
+        .pStages = createInfos.shaderStageCreateInfos.data(),
+        .pVertexInputState = &createInfos.vertexInputStateCreateInfo,
+        .pInputAssemblyState = &createInfos.inputAssemblyStateCreateInfo,
+        .pViewportState = &createInfos.viewportStateCreateInfo,
+        .pRasterizationState = &createInfos.rasterizationStateCreateInfo,
+        .pMultisampleState = &createInfos.multisampleStateCreateInfo,
+        .pDepthStencilState = &createInfos.depthStencilStateCreateInfo,
+        .pColorBlendState = &createInfos.colorBlendStateCreateInfo,
+        .pDynamicState = &createInfos.dynamicStateCreateInfo,
+        .layout = state.layout,
+        .renderPass = state.renderPass,
+        .subpass = 0
+    };
+
+    VkPipeline pipeline;
+    VK_CHECK_ERROR(vkCreateGraphicsPipelines(mDevice,
+                                             pipelineCache,
+                                             1,
+                                             &graphicsPipelineCreateInfo,
+                                             mHostAllocator.callbacks(VK_OBJECT_TYPE_PIPELINE),
+                                             &pipeline));
+
+    return pipeline;
+}
+
+VkPipeline VkPipelineManager::library(LibraryPart part,
+                                      const VkGraphicsPipelineState &state,
+                                      VkPipelineCache pipelineCache) {
+    // ================================================================================
+    // 1. 라이브러리에 영향을 주는 상태만으로 키 생성
+    // ================================================================================
+    vector<uint8_t> key;
+    appendKey(&key, state.flags);
+    switch (part) {
+        case kVertexInputInterface:
+            appendKey(&key, state.vertexBindingDescriptions);
+            appendKey(&key, state.vertexAttributeDescriptions);
+            appendKey(&key, state.topology);
+            break;
+        case kPreRasterizationShaders:
+            appendKey(&key, state.vertexShaderModule);
+            appendKey(&key, state.specializationMapEntries);
+            appendKey(&key, state.specializationData);
+            appendKey(&key, state.cullMode);
+            appendKey(&key, state.layout);
+            appendKey(&key, state.renderPass);
+            break;
+        case kFragmentShader:
+            appendKey(&key, state.fragmentShaderModule);
+            appendKey(&key, state.specializationMapEntries);
+            appendKey(&key, state.specializationData);
+            appendKey(&key, state.depthTestEnable);
+            appendKey(&key, state.depthWriteEnable);
+            appendKey(&key, state.depthCompareOp);
+            appendKey(&key, state.layout);
+            appendKey(&key, state.renderPass);
+            break;
+        case kFragmentOutputInterface:
+            appendKey(&key, state.colorFormat);
+            appendKey(&key, state.depthFormat);
+            appendKey(&key, state.stencilFormat);
+            appendKey(&key, state.renderPass);
+            break;
+        default:
+            assert(false);
+            break;
+    }
+    auto hash = hashCombine(kHashSeed, key);
+
+    // 해시가 같아도 상태가 다를 수 있으므로 키 바이트까지 비교한다.
+    auto findLibrary = [this, part, hash, &key]() -> VkPipeline {
+        auto [first, last] = mLibraries[part].equal_range(hash);
+        for (auto iter = first; iter != last; ++iter) {
+            if (iter->second.first == key) {
+                return iter->second.second;
+            }
+        }
+        return VK_NULL_HANDLE;
+    };
+
+    {
+        lock_guard<mutex> lock(mLibraryMutex);
+        if (auto library = findLibrary()) {
+            ++mLibraryHitCount;
+            return library;
+        }
+    }
+
+    // ================================================================================
+    // 2. 라이브러리 생성
+    // ================================================================================
+    PipelineCreateInfos createInfos(state);
+
+    auto dynamicRendering = state.renderPass == VK_NULL_HANDLE;
+    VkGraphicsPipelineLibraryCreateInfoEXT graphicsPipelineLibraryCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+        .pNext = dynamicRendering ? &createInfos.renderingCreateInfo : nullptr
+    };
+
+    VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = &graphicsPipelineLibraryCreateInfo,
+        .flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR |
+                 VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT |
+                 state.flags
+    };
+
+    switch (part) {
+        case kVertexInputInterface:
+            graphicsPipelineLibraryCreateInfo.flags =
+                    VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT;
+            // Vertex input 라이브러리는 렌더링 정보가 필요 없다.
+            graphicsPipelineLibraryCreateInfo.pNext = nullptr;
+            graphicsPipelineCreateInfo.pVertexInputState =
+                    &createInfos.vertexInputStateCreateInfo;
+            graphicsPipelineCreateInfo.pInputAssemblyState =
+                    &createInfos.inputAssemblyStateCreateInfo;
+            break;
+        case kPreRasterizationShaders:
+            graphicsPipelineLibraryCreateInfo.flags =
+                    VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT;
+            graphicsPipelineCreateInfo.stageCount = 1;
+            graphicsPipelineCreateInfo.pStages = &createInfos.shaderStageCreateInfos[0];
+            graphicsPipelineCreateInfo.pViewportState = &createInfos.viewportStateCreateInfo;
+            graphicsPipelineCreateInfo.pRasterizationState =
+                    &createInfos.rasterizationStateCreateInfo;
+            graphicsPipelineCreateInfo.pDynamicState = &createInfos.dynamicStateCreateInfo;
+            graphicsPipelineCreateInfo.layout = state.layout;
+            graphicsPipelineCreateInfo.renderPass = state.renderPass;
+            break;
+        case kFragmentShader:
+            graphicsPipelineLibraryCreateInfo.flags =
+                    VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT;
+            graphicsPipelineCreateInfo.stageCount = 1;
+            graphicsPipelineCreateInfo.pStages = &createInfos.shaderStageCreateInfos[1];
+            graphicsPipelineCreateInfo.pMultisampleState = &createInfos.multisampleStateCreateInfo;
+            graphicsPipelineCreateInfo.pDepthStencilState =
+                    &createInfos.depthStencilStateCreateInfo;
+            graphicsPipelineCreateInfo.layout = state.layout;
+            graphicsPipelineCreateInfo.renderPass = state.renderPass;
+            break;
+        case kFragmentOutputInterface:
+            graphicsPipelineLibraryCreateInfo.flags =
+                    VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT;
+            graphicsPipelineCreateInfo.pMultisampleState = &createInfos.multisampleStateCreateInfo;
+            graphicsPipelineCreateInfo.pColorBlendState = &createInfos.colorBlendStateCreateInfo;
+            graphicsPipelineCreateInfo.renderPass = state.renderPass;
+            break;
+        default:
+            assert(false);
+            break;
+    }
+
+    VkPipeline library;
+    VK_CHECK_ERROR(vkCreateGraphicsPipelines(mDevice,
+                                             pipelineCache,
+                                             1,
+                                             &graphicsPipelineCreateInfo,
+                                             mHostAllocator.callbacks(VK_OBJECT_TYPE_PIPELINE),
+                                             &library));
+
+    // ================================================================================
+    // 3. 라이브러리 등록
+    // ================================================================================
+    lock_guard<mutex> lock(mLibraryMutex);
+    // 다른 작업이 먼저 같은 라이브러리를 등록했다면 그것을 사용한다.
+    if (auto registeredLibrary = findLibrary()) {
+        vkDestroyPipeline(mDevice, library, mHostAllocator.callbacks(VK_OBJECT_TYPE_PIPELINE));
+        ++mLibraryHitCount;
+        return registeredLibrary;
+    }
+
+    mLibraries[part].emplace(hash, make_pair(std::move(key), library));
+    ++mLibraryMissCount;
+
+    return library;
+}
+
+VkPipeline VkPipelineManager::linkLibraries(const array<VkPipeline, kLibraryPartCount> &libraries,
+                                            const VkGraphicsPipelineState &state,
+                                            VkPipelineCache pipelineCache,
+                                            bool optimize) {
+    VkPipelineLibraryCreateInfoKHR pipelineLibraryCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
+        .libraryCount = static_cast<uint32_t>(libraries.size()),
+        .pLibraries = libraries.data()
+    };
+
+    VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = &pipelineLibraryCreateInfo,
+        .flags = (optimize ? VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT : 0u) | state.flags,
+        .layout = state.layout
+    };
+
+    VkPipeline pipeline;
+    VK_CHECK_ERROR(vkCreateGraphicsPipelines(mDevice,
+                                             pipelineCache,
+                                             1,
+                                             &graphicsPipelineCreateInfo,
+                                             mHostAllocator.callbacks(VK_OBJECT_TYPE_PIPELINE),
+                                             &pipeline));
+
+    return pipeline;
+}
+
+void VkPipelineManager::publish(Entry &entry, VkPipeline pipeline) {
+    entry.pipeline.store(pipeline, memory_order_release);
+    {
+        lock_guard<mutex> lock(mMutex);
+        entry.ready = true;
+    }
+    mReadyCondition.notify_all();
+}
@@ -0,0 +1,154 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKPIPELINEMANAGER_H
+#define PRACTICE_VULKAN_VKPIPELINEMANAGER_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "JobSystem.h"
+#include "VkHostAllocator.h"
+#include "VkPipelineCacheStore.h"
+
+/*!
+ * Everything needed to build a graphics pipeline, held by value so that it can be handed to a
+ * worker thread.
+ */
+struct VkGraphicsPipelineState {
+    // 모든 라이브러리와 파이프라인에 같이 적용한다. (예: descriptor buffer)
+    VkPipelineCreateFlags flags = 0;
+    VkShaderModule vertexShaderModule = VK_NULL_HANDLE;
+    VkShaderModule fragmentShaderModule = VK_NULL_HANDLE;
+    // 두 스테이지에 같은 specialization constant를 적용한다.
+    std::vector<VkSpecializationMapEntry> specializationMapEntries;
+    std::vector<uint8_t> specializationData;
+    std::vector<VkVertexInputBindingDescription> vertexBindingDescriptions;
+    std::vector<VkVertexInputAttributeDescription> vertexAttributeDescriptions;
+    VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    VkCullModeFlags cullMode = VK_CULL_MODE_NONE;
+    VkBool32 depthTestEnable = VK_TRUE;
+    VkBool32 depthWriteEnable = VK_TRUE;
+    VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    // Dynamic rendering에서는 renderPass 대신 attachment 포맷을 사용한다.
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+    VkFormat colorFormat = VK_FORMAT_UNDEFINED;
+    VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+    VkFormat stencilFormat = VK_FORMAT_UNDEFINED;
+};
+
+/*!
+ * Compiles graphics pipelines on the JobSystem.
+ *
+ * request() returns a handle right away and pipeline() stays VK_NULL_HANDLE until the worker
+ * has finished, so the render thread can draw with a fallback instead of waiting for the
+ * driver. Each job compiles into its own VkPipelineCache and merges it into the shared one.
+ * request() may be called from any thread; entries live in a fixed array so that pipeline()
+ * never takes a lock. Once the array is full request() returns kInvalidHandle, for which
+ * pipeline() stays VK_NULL_HANDLE and the caller keeps drawing with its fallback.
+ *
+ * With VK_EXT_graphics_pipeline_library the four pipeline parts are compiled once per unique
+ * state and shared between pipelines. A fast-linked pipeline is published first and replaced
+ * by a link-time optimized one when the background link finishes.
+ */
+class VkPipelineManager {
+public:
+    using Handle = uint32_t;
+
+    static constexpr uint32_t kMaxPipelineCount = 1024;
+    static constexpr Handle kInvalidHandle = UINT32_MAX;
+
+    VkPipelineManager(VkHostAllocator &hostAllocator,
+                      VkDevice device,
+                      VkPipelineCacheStore &pipelineCache,
+                      JobSystem &jobSystem,
+                      bool graphicsPipelineLibraryEnabled);
+    ~VkPipelineManager();
+
+    VkPipelineManager(const VkPipelineManager &) = delete;
+    VkPipelineManager &operator=(const VkPipelineManager &) = delete;
+
+    Handle request(VkGraphicsPipelineState state);
+    VkPipeline pipeline(Handle handle) const;
+    void wait(Handle handle);
+    uint32_t pendingCount() const { return mPendingCount; }
+    void report() const;
+
+private:
+    enum LibraryPart {
+        kVertexInputInterface,
+        kPreRasterizationShaders,
+        kFragmentShader,
+        kFragmentOutputInterface,
+        kLibraryPartCount
+    };
+
+    struct Entry {
+        VkGraphicsPipelineState state;
+        std::atomic<VkPipeline> pipeline = VK_NULL_HANDLE;
+        std::atomic<bool> ready = false;
+        // 최적화된 파이프라인으로 교체된 후에도 GPU가 사용 중일 수 있어 파괴를 미룬다.
+        VkPipeline retiredPipeline = VK_NULL_HANDLE;
+    };
+
+    void compile(Entry &entry);
+    VkPipeline createMonolithicPipeline(const VkGraphicsPipelineState &state,
+                                        VkPipelineCache pipelineCache);
+    VkPipeline library(LibraryPart part,
+                       const VkGraphicsPipelineState &state,
+                       VkPipelineCache pipelineCache);
+    VkPipeline linkLibraries(const std::array<VkPipeline, kLibraryPartCount> &libraries,
+                             const VkGraphicsPipelineState &state,
+                             VkPipelineCache pipelineCache,
+                             bool optimize);
+    void publish(Entry &entry, VkPipeline pipeline);
+
+    VkHostAllocator &mHostAllocator;
+    VkDevice mDevice;
+    VkPipelineCacheStore &mPipelineCache;
+    JobSystem &mJobSystem;
+    bool mGraphicsPipelineLibraryEnabled;
+    // 해시가 충돌해도 다른 라이브러리를 쓰지 않도록 키를 만든 상태 바이트를 같이 저장한다.
+    std::array<std::unordered_multimap<uint64_t, std::pair<std::vector<uint8_t>, VkPipeline>>,
+               kLibraryPartCount> mLibraries;
+    std::mutex mLibraryMutex;
+    std::atomic<uint32_t> mLibraryHitCount = 0;
+    std::atomic<uint32_t> mLibraryMissCount = 0;
+    std::atomic<uint64_t> mFastLinkTime = 0;
+    std::unique_ptr<Entry[]> mEntries;
+    std::atomic<uint32_t> mEntryCount = 0;
+    std::atomic<uint32_t> mPendingCount = 0;
+    std::atomic<uint32_t> mRejectedCount = 0;
+    std::atomic<uint32_t> mCompileCount = 0;
+    std::atomic<uint64_t> mCompileTime = 0;
+    std::mutex mMutex;
+    std::condition_variable mReadyCondition;
+};
+
+#endif //PRACTICE_VULKAN_VKPIPELINEMANAGER_H
@@ -0,0 +1,142 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iomanip>
+
+#include "VkProfiler.h"
+#include "VkUtil.h"
+#include "AndroidOut.h"
+
+using namespace std;
+
+VkProfiler::VkProfiler(VkHostAllocator &hostAllocator,
+                       VkDevice device,
+                       uint32_t timestampValidBits,
+                       float timestampPeriod)
+        : mHostAllocator(hostAllocator),
+          mDevice(device),
+          mTimestampMask(timestampValidBits >= 64 ? UINT64_MAX : (1ull << timestampValidBits) - 1),
+          mTimestampPeriod(timestampPeriod) {
+    // 타임스탬프를 지원하지 않는 큐에서는 CPU 시간만 측정한다.
+    if (!timestampValidBits) {
+        return;
+    }
+
+    VkQueryPoolCreateInfo queryPoolCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+        .queryType = VK_QUERY_TYPE_TIMESTAMP,
+        .queryCount = kSlotCount * 2
+    };
+
+    VK_CHECK_ERROR(vkCreateQueryPool(mDevice,
+                                     &queryPoolCreateInfo,
+                                     mHostAllocator.callbacks(VK_OBJECT_TYPE_QUERY_POOL),
+                                     &mQueryPool));
+}
+
+VkProfiler::~VkProfiler() {
+    if (mQueryPool != VK_NULL_HANDLE) {
+        vkDestroyQueryPool(mDevice,
+                           mQueryPool,
+                           mHostAllocator.callbacks(VK_OBJECT_TYPE_QUERY_POOL));
+    }
+}
+
+void VkProfiler::begin(VkCommandBuffer commandBuffer) {
+    auto now = chrono::steady_clock::now();
+    if (mFrameCount) {
+        mFrameTime += chrono::duration<double, milli>(now - mLastFrameTime).count();
+    }
+    mLastFrameTime = now;
+    mCpuBeginTime = now;
+
+    if (mQueryPool == VK_NULL_HANDLE) {
+        return;
+    }
+
+    // 이번 프레임이 재사용할 슬롯에 이전 결과가 있으면 기다리지 않고 읽는다.
+    if (mSlotRecorded[mSlot]) {
+        array<uint64_t, 4> results{};
+        auto result = vkGetQueryPoolResults(mDevice,
+                                            mQueryPool,
+                                            mSlot * 2,
+                                            2,
+                                            sizeof(results),
+                                            results.data(),
+                                            sizeof(uint64_t) * 2,
+                                            VK_QUERY_RESULT_64_BIT |
+                                            VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        if (result == VK_SUCCESS && results[1] && results[3]) {
+            auto ticks = (results[2] - results[0]) & mTimestampMask;
+            mGpuTime += ticks * mTimestampPeriod / 1000000.0;
+            ++mGpuFrameCount;
+        }
+    }
+
+    vkCmdResetQueryPool(commandBuffer, mQueryPool, mSlot * 2, 2);
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, mQueryPool, mSlot * 2);
+}
+
+bool VkProfiler::end(VkCommandBuffer commandBuffer, uint32_t drawCount, uint64_t triangleCount) {
+    if (mQueryPool != VK_NULL_HANDLE) {
+        vkCmdWriteTimestamp(commandBuffer,
+                            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                            mQueryPool,
+                            mSlot * 2 + 1);
+        mSlotRecorded[mSlot] = true;
+        mSlot = (mSlot + 1) % kSlotCount;
+    }
+
+    auto now = chrono::steady_clock::now();
+    mCpuTime += chrono::duration<double, milli>(now - mCpuBeginTime).count();
+    mDrawCount += drawCount;
+    mTriangleCount += triangleCount;
+
+    if (++mFrameCount == kReportInterval) {
+        report();
+        return true;
+    }
+
+    return false;
+}
+
+void VkProfiler::report() {
+    auto frameTime = mFrameTime / (mFrameCount - 1);
+    aout << "Profiler Information (" << mLabel << ") ↓" << endl;
+    aout << fixed << setprecision(3);
+    aout << setw(16) << left << " - FPS: " << 1000.0 / frameTime << endl;
+    aout << setw(16) << left << " - CPU Record: " << mCpuTime / mFrameCount << " ms" << endl;
+    if (mGpuFrameCount) {
+        aout << setw(16) << left << " - GPU: " << mGpuTime / mGpuFrameCount << " ms" << endl;
+    }
+    aout << defaultfloat;
+    aout << setw(16) << left << " - Draws: " << mDrawCount / mFrameCount << endl;
+    aout << setw(16) << left << " - Triangles: " << mTriangleCount / mFrameCount << endl;
+
+    mFrameCount = 0;
+    mGpuFrameCount = 0;
+    mCpuTime = 0.0;
+    mFrameTime = 0.0;
+    mGpuTime = 0.0;
+    mDrawCount = 0;
+    mTriangleCount = 0;
+}
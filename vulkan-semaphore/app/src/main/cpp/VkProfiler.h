@@ -0,0 +1,78 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKPROFILER_H
+#define PRACTICE_VULKAN_VKPROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vulkan/vulkan.h>
+
+#include "VkHostAllocator.h"
+
+/*!
+ * Measures CPU recording time, frame time and GPU time with timestamp queries and logs the
+ * averages every kReportInterval frames. GPU results are read back a few frames later without
+ * waiting, so profiling never stalls the render thread.
+ */
+class VkProfiler {
+public:
+    VkProfiler(VkHostAllocator &hostAllocator,
+               VkDevice device,
+               uint32_t timestampValidBits,
+               float timestampPeriod);
+    ~VkProfiler();
+
+    void setLabel(std::string label) { mLabel = std::move(label); }
+    void begin(VkCommandBuffer commandBuffer);
+    // 이번 프레임에 리포트를 남겼으면 true를 반환한다.
+    bool end(VkCommandBuffer commandBuffer, uint32_t drawCount, uint64_t triangleCount);
+
+private:
+    static constexpr uint32_t kSlotCount = 4;
+    static constexpr uint32_t kReportInterval = 120;
+
+    void report();
+
+    VkHostAllocator &mHostAllocator;
+    VkDevice mDevice;
+    uint64_t mTimestampMask;
+    float mTimestampPeriod;
+    VkQueryPool mQueryPool = VK_NULL_HANDLE;
+    std::array<bool, kSlotCount> mSlotRecorded{};
+    uint32_t mSlot = 0;
+    std::string mLabel = "Pipeline";
+
+    std::chrono::steady_clock::time_point mCpuBeginTime;
+    std::chrono::steady_clock::time_point mLastFrameTime;
+    uint32_t mFrameCount = 0;
+    uint32_t mGpuFrameCount = 0;
+    double mCpuTime = 0.0;
+    double mFrameTime = 0.0;
+    double mGpuTime = 0.0;
+    uint64_t mDrawCount = 0;
+    uint64_t mTriangleCount = 0;
+};
+
+#endif //PRACTICE_VULKAN_VKPROFILER_H
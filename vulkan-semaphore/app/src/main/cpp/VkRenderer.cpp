@@ -24,14 +24,34 @@
 #include <array>
 #include <vector>
 #include <iomanip>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
 
 #include "VkRenderer.h"
 #include "VkUtil.h"
+#include "VkShaders.h"
+#include "VkObjectCache.h"
+#include "VkShaderObjects.h"
+#include "Settings.h"
 #include "AndroidOut.h"
 
 using namespace std;
 
-VkRenderer::VkRenderer(ANativeWindow *window) {
+namespace {
+
+struct Vertex {
+    float position[2];
+    float color[3];
+};
+
+struct DrawData {
+    float tint[4];
+};
+
+}
+
+VkRenderer::VkRenderer(ANativeWindow *window, const string &dataPath) {
     // ================================================================================
     // 1. VkInstance 생성
     // ================================================================================
@@ -82,7 +102,9 @@ VkRenderer::VkRenderer(ANativeWindow *window) {
         .ppEnabledExtensionNames = instanceExtensionNames.data()
     };
 
-    VK_CHECK_ERROR(vkCreateInstance(&instanceCreateInfo, nullptr, &mInstance));
+    VK_CHECK_ERROR(vkCreateInstance(&instanceCreateInfo,
+                                    mHostAllocator.callbacks(VK_OBJECT_TYPE_INSTANCE),
+                                    &mInstance));
 
     // ================================================================================
     // 2. VkPhysicalDevice 선택
@@ -108,6 +130,11 @@ VkRenderer::VkRenderer(ANativeWindow *window) {
     aout << std::hex;
     aout << setw(16) << left << " - Device ID: " << physicalDeviceProperties.deviceID << endl;
     aout << setw(16) << left << " - Vendor ID: " << physicalDeviceProperties.vendorID << endl;
+    aout << setw(16) << left << " - Cache UUID: ";
+    for (auto byte : physicalDeviceProperties.pipelineCacheUUID) {
+        aout << setw(2) << right << setfill('0') << static_cast<uint32_t>(byte);
+    }
+    aout << setfill(' ') << endl;
     aout << std::dec;
     aout << setw(16) << left << " - API Version: "
          << VK_API_VERSION_MAJOR(physicalDeviceProperties.apiVersion) << "."
@@ -133,14 +160,36 @@ VkRenderer::VkRenderer(ANativeWindow *window) {
         }
     }
 
+    // 그래픽스를 지원하지 않는 전송 전용 큐가 있으면 업로드에 사용한다.
+    mTransferQueueFamilyIndex = mQueueFamilyIndex;
+    for (auto i = 0; i != queueFamilyPropertiesCount; ++i) {
+        auto queueFlags = queueFamilyProperties[i].queueFlags;
+        if ((queueFlags & VK_QUEUE_TRANSFER_BIT) &&
+            !(queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+            mTransferQueueFamilyIndex = i;
+            break;
+        }
+    }
+
     const vector<float> queuePriorities{1.0};
-    VkDeviceQueueCreateInfo deviceQueueCreateInfo{
-        .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
-        .queueFamilyIndex = mQueueFamilyIndex,
-        .queueCount = 1,
-        .pQueuePriorities = queuePriorities.data()
+    vector<VkDeviceQueueCreateInfo> deviceQueueCreateInfos{
+        {
+            .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+            .queueFamilyIndex = mQueueFamilyIndex,
+            .queueCount = 1,
+            .pQueuePriorities = queuePriorities.data()
+        }
     };
 
+    if (mTransferQueueFamilyIndex != mQueueFamilyIndex) {
+        deviceQueueCreateInfos.push_back({
+            .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+            .queueFamilyIndex = mTransferQueueFamilyIndex,
+            .queueCount = 1,
+            .pQueuePriorities = queuePriorities.data()
+        });
+    }
+
     uint32_t deviceExtensionCount;
     VK_CHECK_ERROR(vkEnumerateDeviceExtensionProperties(mPhysicalDevice,
                                                         nullptr,
@@ -161,16 +210,326 @@ VkRenderer::VkRenderer(ANativeWindow *window) {
     }
     assert(deviceExtensionNames.size() == 1);
 
+    auto isDeviceExtensionSupported = [&](string_view extensionName) {
+        for (const auto &properties: deviceExtensionProperties) {
+            if (extensionName == properties.extensionName) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto memoryBudgetEnabled = isDeviceExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    if (memoryBudgetEnabled) {
+        deviceExtensionNames.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
+
+    // Dynamic rendering은 Vulkan 1.3의 핵심 기능이고 이전 버전에서는 확장으로 제공된다.
+    auto dynamicRenderingExtensionRequired =
+            physicalDeviceProperties.apiVersion < VK_API_VERSION_1_3;
+    auto dynamicRenderingAvailable =
+            !dynamicRenderingExtensionRequired ||
+            (isDeviceExtensionSupported(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME) &&
+             (physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_2 ||
+              (isDeviceExtensionSupported(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME) &&
+               isDeviceExtensionSupported(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME))));
+
+    // 비교 측정을 위해 설정으로 파이프라인 라이브러리를 끌 수 있다.
+    auto graphicsPipelineLibraryAvailable =
+            getIntSetting("debug.practicevulkan.pipeline_library", 1) &&
+            isDeviceExtensionSupported(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME) &&
+            isDeviceExtensionSupported(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+
+    void *supportedFeaturesNext = nullptr;
+    VkPhysicalDeviceDynamicRenderingFeatures supportedDynamicRenderingFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES
+    };
+    if (dynamicRenderingAvailable) {
+        vkChain(&supportedFeaturesNext, &supportedDynamicRenderingFeatures);
+    }
+
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT supportedGraphicsPipelineLibraryFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT
+    };
+    if (graphicsPipelineLibraryAvailable) {
+        vkChain(&supportedFeaturesNext, &supportedGraphicsPipelineLibraryFeatures);
+    }
+
+    // Descriptor indexing은 Vulkan 1.2의 핵심 기능이고 이전 버전에서는 확장으로 제공된다.
+    auto descriptorIndexingExtensionRequired =
+            physicalDeviceProperties.apiVersion < VK_API_VERSION_1_2;
+    auto descriptorIndexingAvailable =
+            !descriptorIndexingExtensionRequired ||
+            (isDeviceExtensionSupported(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) &&
+             isDeviceExtensionSupported(VK_KHR_MAINTENANCE_3_EXTENSION_NAME));
+    VkPhysicalDeviceDescriptorIndexingFeatures supportedDescriptorIndexingFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES
+    };
+    if (descriptorIndexingAvailable) {
+        vkChain(&supportedFeaturesNext, &supportedDescriptorIndexingFeatures);
+    }
+
+    // Descriptor buffer는 buffer device address와 synchronization2에 의존하므로
+    // 둘 다 핵심 기능인 Vulkan 1.3 기기에서만 사용한다.
+    auto descriptorBufferAvailable =
+            physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_3 &&
+            isDeviceExtensionSupported(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME);
+    VkPhysicalDeviceDescriptorBufferFeaturesEXT supportedDescriptorBufferFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT
+    };
+    VkPhysicalDeviceBufferDeviceAddressFeatures supportedBufferDeviceAddressFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES
+    };
+    if (descriptorBufferAvailable) {
+        vkChain(&supportedFeaturesNext, &supportedDescriptorBufferFeatures);
+        vkChain(&supportedFeaturesNext, &supportedBufferDeviceAddressFeatures);
+    }
+
+    auto shaderObjectAvailable = isDeviceExtensionSupported(VK_EXT_SHADER_OBJECT_EXTENSION_NAME);
+    VkPhysicalDeviceShaderObjectFeaturesEXT supportedShaderObjectFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_FEATURES_EXT
+    };
+    if (shaderObjectAvailable) {
+        vkChain(&supportedFeaturesNext, &supportedShaderObjectFeatures);
+    }
+
+    // Present wait는 출력 ID로 기다리므로 present id와 함께 사용한다.
+    auto presentWaitAvailable = isDeviceExtensionSupported(VK_KHR_PRESENT_ID_EXTENSION_NAME) &&
+                                isDeviceExtensionSupported(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+    VkPhysicalDevicePresentIdFeaturesKHR supportedPresentIdFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR
+    };
+    VkPhysicalDevicePresentWaitFeaturesKHR supportedPresentWaitFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR
+    };
+    if (presentWaitAvailable) {
+        vkChain(&supportedFeaturesNext, &supportedPresentIdFeatures);
+        vkChain(&supportedFeaturesNext, &supportedPresentWaitFeatures);
+    }
+
+    VkPhysicalDeviceFeatures2 supportedFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+        .pNext = supportedFeaturesNext
+    };
+    vkGetPhysicalDeviceFeatures2(mPhysicalDevice, &supportedFeatures);
+
+    void *deviceCreateInfoNext = nullptr;
+    VkPhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES,
+        .dynamicRendering = VK_TRUE
+    };
+
+    mDynamicRenderingEnabled =
+            dynamicRenderingAvailable && supportedDynamicRenderingFeatures.dynamicRendering;
+    if (mDynamicRenderingEnabled) {
+        vkChain(&deviceCreateInfoNext, &dynamicRenderingFeatures);
+        if (dynamicRenderingExtensionRequired) {
+            deviceExtensionNames.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+            if (physicalDeviceProperties.apiVersion < VK_API_VERSION_1_2) {
+                deviceExtensionNames.push_back(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME);
+                deviceExtensionNames.push_back(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME);
+            }
+        }
+    }
+
+    // 지원하지 않으면 모놀리식 파이프라인을 사용한다.
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT graphicsPipelineLibraryFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT,
+        .graphicsPipelineLibrary = VK_TRUE
+    };
+
+    mGraphicsPipelineLibraryEnabled =
+            graphicsPipelineLibraryAvailable &&
+            supportedGraphicsPipelineLibraryFeatures.graphicsPipelineLibrary;
+    if (mGraphicsPipelineLibraryEnabled) {
+        vkChain(&deviceCreateInfoNext, &graphicsPipelineLibraryFeatures);
+        deviceExtensionNames.push_back(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+        deviceExtensionNames.push_back(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+    }
+
+    // Shader object는 VkRenderPass를 사용할 수 없으므로 dynamic rendering이 필요하다.
+    VkPhysicalDeviceShaderObjectFeaturesEXT shaderObjectFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_FEATURES_EXT,
+        .shaderObject = VK_TRUE
+    };
+
+    mShaderObjectEnabled = shaderObjectAvailable &&
+                           supportedShaderObjectFeatures.shaderObject &&
+                           mDynamicRenderingEnabled;
+    if (mShaderObjectEnabled) {
+        vkChain(&deviceCreateInfoNext, &shaderObjectFeatures);
+        deviceExtensionNames.push_back(VK_EXT_SHADER_OBJECT_EXTENSION_NAME);
+    }
+
+    void *propertiesNext = nullptr;
+    VkPhysicalDeviceDescriptorIndexingProperties descriptorIndexingProperties{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES
+    };
+    if (descriptorIndexingAvailable) {
+        vkChain(&propertiesNext, &descriptorIndexingProperties);
+    }
+
+    VkPhysicalDeviceDescriptorBufferPropertiesEXT descriptorBufferProperties{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT
+    };
+    if (descriptorBufferAvailable) {
+        vkChain(&propertiesNext, &descriptorBufferProperties);
+    }
+
+    VkPhysicalDeviceProperties2 physicalDeviceProperties2{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+        .pNext = propertiesNext
+    };
+    vkGetPhysicalDeviceProperties2(mPhysicalDevice, &physicalDeviceProperties2);
+
+    // Bindless 텍스처 배열은 셰이더가 쓰는 크기만큼 update after bind 슬롯이 있어야 한다.
+
+    auto bindlessTextureLimit =
+            min({descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers,
+                 descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                 descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindSamplers,
+                 descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindSampledImages});
+
+    VkPhysicalDeviceDescriptorIndexingFeatures descriptorIndexingFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES,
+        .descriptorBindingSampledImageUpdateAfterBind = VK_TRUE,
+        .descriptorBindingPartiallyBound = VK_TRUE
+    };
+
+    mBindlessEnabled =
+            descriptorIndexingAvailable &&
+            supportedDescriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind &&
+            supportedDescriptorIndexingFeatures.descriptorBindingPartiallyBound &&
+            supportedFeatures.features.shaderSampledImageArrayDynamicIndexing &&
+            bindlessTextureLimit >= VkBindlessTable::kMaxTextureCount;
+    if (mBindlessEnabled) {
+        vkChain(&deviceCreateInfoNext, &descriptorIndexingFeatures);
+        if (descriptorIndexingExtensionRequired) {
+            deviceExtensionNames.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+            deviceExtensionNames.push_back(VK_KHR_MAINTENANCE_3_EXTENSION_NAME);
+        }
+    }
+
+    // 실행 중에 디스크립터 관리 방식을 비교할 수 있도록 지원하면 항상 활성화한다.
+    VkPhysicalDeviceDescriptorBufferFeaturesEXT descriptorBufferFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT,
+        .descriptorBuffer = VK_TRUE
+    };
+    VkPhysicalDeviceBufferDeviceAddressFeatures bufferDeviceAddressFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES,
+        .bufferDeviceAddress = VK_TRUE
+    };
+
+    mDescriptorBufferEnabled = descriptorBufferAvailable &&
+                               supportedDescriptorBufferFeatures.descriptorBuffer &&
+                               supportedBufferDeviceAddressFeatures.bufferDeviceAddress;
+    if (mDescriptorBufferEnabled) {
+        vkChain(&deviceCreateInfoNext, &descriptorBufferFeatures);
+        vkChain(&deviceCreateInfoNext, &bufferDeviceAddressFeatures);
+        deviceExtensionNames.push_back(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME);
+    }
+
+    // Push descriptor는 기능 구조체 없이 확장만 활성화하면 된다.
+    mPushDescriptorEnabled = isDeviceExtensionSupported(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+    if (mPushDescriptorEnabled) {
+        deviceExtensionNames.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+    }
+
+    // 바뀐 영역만 컴포지터에 알려서 화면 합성 시의 메모리 대역폭을 줄인다.
+    mIncrementalPresentEnabled =
+            isDeviceExtensionSupported(VK_KHR_INCREMENTAL_PRESENT_EXTENSION_NAME);
+    if (mIncrementalPresentEnabled) {
+        deviceExtensionNames.push_back(VK_KHR_INCREMENTAL_PRESENT_EXTENSION_NAME);
+    }
+
+    // 실제 출력 시각과 주사율을 알아야 출력 간격을 고르게 맞출 수 있다.
+    mDisplayTimingEnabled = isDeviceExtensionSupported(VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME);
+    if (mDisplayTimingEnabled) {
+        deviceExtensionNames.push_back(VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME);
+    }
+
+    // 화면에 나가지 않은 출력이 쌓이지 않게 해서 입력부터 화면까지의 지연을 제한한다.
+    VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR,
+        .presentId = VK_TRUE
+    };
+    VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR,
+        .presentWait = VK_TRUE
+    };
+
+    mPresentWaitEnabled = presentWaitAvailable &&
+                          supportedPresentIdFeatures.presentId &&
+                          supportedPresentWaitFeatures.presentWait;
+    if (mPresentWaitEnabled) {
+        vkChain(&deviceCreateInfoNext, &presentIdFeatures);
+        vkChain(&deviceCreateInfoNext, &presentWaitFeatures);
+        deviceExtensionNames.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+        deviceExtensionNames.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+    }
+
+    // GPU가 직접 draw를 만들려면 한 번에 여러 indirect 명령을 읽고 firstInstance로 오브젝트를
+    // 구분할 수 있어야 한다. 컬링은 그래픽스 큐에서 실행하므로 compute도 지원해야 한다.
+    mGpuDrivenEnabled = supportedFeatures.features.multiDrawIndirect &&
+                        supportedFeatures.features.drawIndirectFirstInstance &&
+                        (queueFamilyProperties[mQueueFamilyIndex].queueFlags &
+                         VK_QUEUE_COMPUTE_BIT);
+
+    // 개수를 GPU 버퍼에서 읽으면 컬링된 명령을 건너뛰지 않아도 된다.
+    mDrawIndirectCountEnabled =
+            mGpuDrivenEnabled &&
+            isDeviceExtensionSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    if (mDrawIndirectCountEnabled) {
+        deviceExtensionNames.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    }
+
+    VkPhysicalDeviceFeatures enabledFeatures{
+        .multiDrawIndirect = mGpuDrivenEnabled,
+        .drawIndirectFirstInstance = mGpuDrivenEnabled,
+        .shaderSampledImageArrayDynamicIndexing = mBindlessEnabled
+    };
+
     VkDeviceCreateInfo deviceCreateInfo{
         .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-        .queueCreateInfoCount = 1,
-        .pQueueCreateInfos = &deviceQueueCreateInfo,
+        .pNext = deviceCreateInfoNext,
+        .queueCreateInfoCount = static_cast<uint32_t>(deviceQueueCreateInfos.size()),
+        .pQueueCreateInfos = deviceQueueCreateInfos.data(),
         .enabledExtensionCount = static_cast<uint32_t>(deviceExtensionNames.size()),
-        .ppEnabledExtensionNames = deviceExtensionNames.data()
+        .ppEnabledExtensionNames = deviceExtensionNames.data(),
+        .pEnabledFeatures = &enabledFeatures
     };
 
-    VK_CHECK_ERROR(vkCreateDevice(mPhysicalDevice, &deviceCreateInfo, nullptr, &mDevice));
+    VK_CHECK_ERROR(vkCreateDevice(mPhysicalDevice,
+                                  &deviceCreateInfo,
+                                  mHostAllocator.callbacks(VK_OBJECT_TYPE_DEVICE),
+                                  &mDevice));
     vkGetDeviceQueue(mDevice, mQueueFamilyIndex, 0, &mQueue);
+    vkGetDeviceQueue(mDevice, mTransferQueueFamilyIndex, 0, &mTransferQueue);
+
+    mMemoryBudget = make_unique<VkMemoryBudget>(mPhysicalDevice, memoryBudgetEnabled);
+
+    if (mDynamicRenderingEnabled) {
+        mCmdBeginRendering = vkGetDeviceProc<PFN_vkCmdBeginRendering>(
+                mDevice, {"vkCmdBeginRendering", "vkCmdBeginRenderingKHR"});
+        mCmdEndRendering = vkGetDeviceProc<PFN_vkCmdEndRendering>(
+                mDevice, {"vkCmdEndRendering", "vkCmdEndRenderingKHR"});
+        assert(mCmdBeginRendering && mCmdEndRendering);
+    }
+
+    // ================================================================================
+    // 3. VkPipelineCache 생성
+    // ================================================================================
+    mPipelineCache = make_unique<VkPipelineCacheStore>(mHostAllocator,
+                                                       mDevice,
+                                                       physicalDeviceProperties,
+                                                       dataPath + "/pipeline_cache.bin");
+
+    // ================================================================================
+    // 3. VkObjectCache 생성
+    // ================================================================================
+    mObjectCache = make_unique<VkObjectCache>(mHostAllocator,
+                                              mDevice,
+                                              physicalDeviceProperties.limits);
 
     // ================================================================================
     // 4. VkSurface 생성
@@ -180,7 +539,10 @@ VkRenderer::VkRenderer(ANativeWindow *window) {
         .window = window
     };
 
-    VK_CHECK_ERROR(vkCreateAndroidSurfaceKHR(mInstance, &surfaceCreateInfo, nullptr, &mSurface));
+    VK_CHECK_ERROR(vkCreateAndroidSurfaceKHR(mInstance,
+                                             &surfaceCreateInfo,
+                                             mHostAllocator.callbacks(VK_OBJECT_TYPE_SURFACE_KHR),
+                                             &mSurface));
 
     VkBool32 supported;
     VK_CHECK_ERROR(vkGetPhysicalDeviceSurfaceSupportKHR(mPhysicalDevice,
@@ -206,8 +568,8 @@ VkRenderer::VkRenderer(ANativeWindow *window) {
     }
     assert(compositeAlpha != VK_COMPOSITE_ALPHA_FLAG_BITS_MAX_ENUM_KHR);
 
-    VkImageUsageFlags swapchainImageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
-                                            VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    // Clear는 load op으로 처리하므로 color attachment 용도만 필요하다.
+    VkImageUsageFlags swapchainImageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
     assert(surfaceCapabilities.supportedUsageFlags & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT);
 
     uint32_t surfaceFormatCount = 0;
@@ -267,7 +629,10 @@ VkRenderer::VkRenderer(ANativeWindow *window) {
         .presentMode = presentModes[presentModeIndex]
     };
 
-    VK_CHECK_ERROR(vkCreateSwapchainKHR(mDevice, &swapchainCreateInfo, nullptr, &mSwapchain));
+    VK_CHECK_ERROR(vkCreateSwapchainKHR(mDevice,
+                                        &swapchainCreateInfo,
+                                        mHostAllocator.callbacks(VK_OBJECT_TYPE_SWAPCHAIN_KHR),
+                                        &mSwapchain));
 
     uint32_t swapchainImageCount;
     VK_CHECK_ERROR(vkGetSwapchainImagesKHR(mDevice, mSwapchain, &swapchainImageCount, nullptr));
@@ -278,6 +643,168 @@ VkRenderer::VkRenderer(ANativeWindow *window) {
                                            &swapchainImageCount,
                                            mSwapchainImages.data()));
 
+    mSwapchainFormat = swapchainCreateInfo.imageFormat;
+    mSwapchainExtent = swapchainCreateInfo.imageExtent;
+    mDamageTracker = make_unique<VkDamageTracker>(mSwapchainExtent);
+    // 큐에 쌓아 둘 출력 수. 1이면 GPU가 쉬지 않는 선에서 지연이 가장 짧다.
+    auto maxQueuedFrames = max(1, getIntSetting("debug.practicevulkan.queued_frames", 1));
+    mFramePacer = make_unique<VkFramePacer>(mDevice,
+                                            mSwapchain,
+                                            mDisplayTimingEnabled,
+                                            mPresentWaitEnabled,
+                                            static_cast<uint32_t>(maxQueuedFrames));
+
+    // ================================================================================
+    // 5. 깊이 VkAttachment 생성
+    // ================================================================================
+    mDepthFormat = VK_FORMAT_UNDEFINED;
+    for (auto format: {VK_FORMAT_D24_UNORM_S8_UINT, VK_FORMAT_D32_SFLOAT, VK_FORMAT_D16_UNORM}) {
+        VkFormatProperties formatProperties;
+        vkGetPhysicalDeviceFormatProperties(mPhysicalDevice, format, &formatProperties);
+        if (formatProperties.optimalTilingFeatures &
+            VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT) {
+            mDepthFormat = format;
+            break;
+        }
+    }
+    assert(mDepthFormat != VK_FORMAT_UNDEFINED);
+
+    // 깊이 값은 렌더 패스 밖으로 나가지 않으므로 Transient로 생성한다.
+    mDepthAttachment = make_unique<VkAttachment>(mHostAllocator,
+                                                 *mMemoryBudget,
+                                                 mDevice,
+                                                 mDepthFormat,
+                                                 mSwapchainExtent,
+                                                 VK_SAMPLE_COUNT_1_BIT,
+                                                 VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+                                                 true);
+
+    aout << "Depth Attachment Information ↓" << endl;
+    aout << setw(16) << left << " - Memory: "
+         << (mDepthAttachment->isLazilyAllocated() ? "Lazily Allocated" : "Device Local") << endl;
+    aout << setw(16) << left << " - Size: " << mDepthAttachment->size() << " bytes" << endl;
+    aout << setw(16) << left << " - Committed: "
+         << mDepthAttachment->committedSize() << " bytes" << endl;
+
+    // ================================================================================
+    // 5. Swapchain VkImageView 생성
+    // ================================================================================
+    mSwapchainImageViews.resize(mSwapchainImages.size());
+    for (auto i = 0; i != mSwapchainImages.size(); ++i) {
+        VkImageViewCreateInfo imageViewCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+            .image = mSwapchainImages[i],
+            .viewType = VK_IMAGE_VIEW_TYPE_2D,
+            .format = mSwapchainFormat,
+            .subresourceRange = {
+                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                .baseMipLevel = 0,
+                .levelCount = 1,
+                .baseArrayLayer = 0,
+                .layerCount = 1
+            }
+        };
+
+        VK_CHECK_ERROR(vkCreateImageView(mDevice,
+                                         &imageViewCreateInfo,
+                                         mHostAllocator.callbacks(VK_OBJECT_TYPE_IMAGE_VIEW),
+                                         &mSwapchainImageViews[i]));
+    }
+
+    // ================================================================================
+    // 5. VkRenderPass, VkFramebuffer 생성
+    // ================================================================================
+    // Dynamic rendering을 지원하지 않는 경우에만 VkRenderPass를 사용한다.
+    if (!mDynamicRenderingEnabled) {
+        array<VkAttachmentDescription, 2> attachmentDescriptions{
+            VkAttachmentDescription{
+                .format = mSwapchainFormat,
+                .samples = VK_SAMPLE_COUNT_1_BIT,
+                .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+                .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+                .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+                .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+                .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                .finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+            },
+            VkAttachmentDescription{
+                .format = mDepthFormat,
+                .samples = VK_SAMPLE_COUNT_1_BIT,
+                .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+                .storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+                .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+                .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+                .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                .finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+            }
+        };
+
+        VkAttachmentReference colorAttachmentReference{
+            .attachment = 0,
+            .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+        };
+
+        VkAttachmentReference depthAttachmentReference{
+            .attachment = 1,
+            .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+        };
+
+        VkSubpassDescription subpassDescription{
+            .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
+            .colorAttachmentCount = 1,
+            .pColorAttachments = &colorAttachmentReference,
+            .pDepthStencilAttachment = &depthAttachmentReference
+        };
+
+        // 이미지 획득 Semaphore와 이전 프레임의 깊이 쓰기가 끝난 후에 attachment를 쓴다.
+        VkSubpassDependency subpassDependency{
+            .srcSubpass = VK_SUBPASS_EXTERNAL,
+            .dstSubpass = 0,
+            .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                            VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+            .dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                            VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
+            .srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                             VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+        };
+
+        VkRenderPassCreateInfo renderPassCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+            .attachmentCount = static_cast<uint32_t>(attachmentDescriptions.size()),
+            .pAttachments = attachmentDescriptions.data(),
+            .subpassCount = 1,
+            .pSubpasses = &subpassDescription,
+            .dependencyCount = 1,
+            .pDependencies = &subpassDependency
+        };
+
+        mRenderPass = mObjectCache->renderPass(renderPassCreateInfo);
+
+        mFramebuffers.resize(mSwapchainImageViews.size());
+        for (auto i = 0; i != mSwapchainImageViews.size(); ++i) {
+            array<VkImageView, 2> attachments{
+                mSwapchainImageViews[i],
+                mDepthAttachment->imageView()
+            };
+
+            VkFramebufferCreateInfo framebufferCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+                .renderPass = mRenderPass,
+                .attachmentCount = static_cast<uint32_t>(attachments.size()),
+                .pAttachments = attachments.data(),
+                .width = mSwapchainExtent.width,
+                .height = mSwapchainExtent.height,
+                .layers = 1
+            };
+
+            VK_CHECK_ERROR(vkCreateFramebuffer(mDevice,
+                                               &framebufferCreateInfo,
+                                               mHostAllocator.callbacks(VK_OBJECT_TYPE_FRAMEBUFFER),
+                                               &mFramebuffers[i]));
+        }
+    }
+
     // ================================================================================
     // 6. VkCommandPool 생성
     // ================================================================================
@@ -288,10 +815,13 @@ VkRenderer::VkRenderer(ANativeWindow *window) {
         .queueFamilyIndex = mQueueFamilyIndex
     };
 
-    VK_CHECK_ERROR(vkCreateCommandPool(mDevice, &commandPoolCreateInfo, nullptr, &mCommandPool));
+    VK_CHECK_ERROR(vkCreateCommandPool(mDevice,
+                                       &commandPoolCreateInfo,
+                                       mHostAllocator.callbacks(VK_OBJECT_TYPE_COMMAND_POOL),
+                                       &mCommandPool));
 
     // ================================================================================
-    // 6. VkCommandBuffer 할당
+    // 6. 프레임별 VkCommandBuffer, VkFence, VkSemaphore 생성
     // ================================================================================
     VkCommandBufferAllocateInfo commandBufferAllocateInfo{
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
@@ -300,257 +830,1364 @@ VkRenderer::VkRenderer(ANativeWindow *window) {
         .commandBufferCount = 1
     };
 
-    VK_CHECK_ERROR(vkAllocateCommandBuffers(mDevice, &commandBufferAllocateInfo, &mCommandBuffer));
+    // 첫 프레임이 기다리지 않도록 signaled 상태로 생성한다.
+    VkFenceCreateInfo fenceCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+        .flags = VK_FENCE_CREATE_SIGNALED_BIT
+    };
+
+    VkSemaphoreCreateInfo semaphoreCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+    };
+
+    for (auto &frame: mFrames) {
+        VK_CHECK_ERROR(vkAllocateCommandBuffers(mDevice,
+                                                &commandBufferAllocateInfo,
+                                                &frame.commandBuffer));
+        VK_CHECK_ERROR(vkCreateFence(mDevice,
+                                     &fenceCreateInfo,
+                                     mHostAllocator.callbacks(VK_OBJECT_TYPE_FENCE),
+                                     &frame.fence));
+        VK_CHECK_ERROR(vkCreateSemaphore(mDevice,
+                                         &semaphoreCreateInfo,
+                                         mHostAllocator.callbacks(VK_OBJECT_TYPE_SEMAPHORE),
+                                         &frame.imageAcquisitionSemaphore));
+        VK_CHECK_ERROR(vkCreateSemaphore(mDevice,
+                                         &semaphoreCreateInfo,
+                                         mHostAllocator.callbacks(VK_OBJECT_TYPE_SEMAPHORE),
+                                         &frame.renderCompletionSemaphore));
+        frame.descriptorAllocator = make_unique<VkDescriptorAllocator>(mHostAllocator, mDevice);
+    }
 
     // ================================================================================
-    // 7. VkCommandBuffer 기록 시작
+    // 14. VkUploader 생성
     // ================================================================================
-    VkCommandBufferBeginInfo commandBufferBeginInfo{
-        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
-        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+    mUploader = make_unique<VkUploader>(mHostAllocator,
+                                        *mMemoryBudget,
+                                        mDevice,
+                                        mTransferQueueFamilyIndex,
+                                        mTransferQueue,
+                                        mQueueFamilyIndex,
+                                        kStagingRingSize);
+
+    // ================================================================================
+    // 15. VkProfiler 생성
+    // ================================================================================
+    mProfiler = make_unique<VkProfiler>(mHostAllocator,
+                                        mDevice,
+                                        queueFamilyProperties[mQueueFamilyIndex].timestampValidBits,
+                                        physicalDeviceProperties.limits.timestampPeriod);
+
+    // ================================================================================
+    // 16. VkShaderModule 생성
+    // ================================================================================
+    // 디스크립터 관리 방식은 설정으로 고르고 지원하지 않는 방식이면 pooled를 사용한다.
+    auto descriptors = getStringSetting("debug.practicevulkan.descriptors", "pooled");
+    mDescriptorMode = kPooledDescriptors;
+    if (mBindlessEnabled && descriptors == "bindless") {
+        mDescriptorMode = kBindlessDescriptors;
+    } else if (mDescriptorBufferEnabled && descriptors == "buffer") {
+        mDescriptorMode = kDescriptorBuffer;
+    }
+    const auto &fragmentShaderCode = mDescriptorMode == kBindlessDescriptors ?
+                                     kTriangleBindlessFragmentShader : kTriangleFragmentShader;
+
+    // 스트레스 모드에서는 화면을 격자로 나눠서 삼각형마다 draw call을 하나씩 사용한다.
+    auto triangleCount = getIntSetting("debug.practicevulkan.triangles", 1);
+    mTriangleCount = static_cast<uint32_t>(max(1, triangleCount));
+
+    // Draw 데이터는 크기와 maxPushConstantsSize로 경로를 고르고 설정으로 push descriptor를
+    // 강제할 수 있다. Descriptor buffer와 push descriptor를 같이 쓰려면 별도의 기능이
+    // 필요하므로 그 경우에는 push constant만 사용한다.
+    auto drawDataPath = getStringSetting("debug.practicevulkan.draw_data", "auto");
+    mDrawData = make_unique<VkDrawData>(mHostAllocator,
+                                        *mMemoryBudget,
+                                        mDevice,
+                                        *mObjectCache,
+                                        physicalDeviceProperties.limits,
+                                        mPushDescriptorEnabled &&
+                                        mDescriptorMode != kDescriptorBuffer,
+                                        drawDataPath == "push_descriptor",
+                                        VK_SHADER_STAGE_VERTEX_BIT,
+                                        static_cast<uint32_t>(sizeof(DrawData)),
+                                        1,
+                                        mTriangleCount,
+                                        kFrameCount);
+    const auto &vertexShaderCode = mDrawData->path() == VkDrawData::kPushConstants ?
+                                   kTriangleVertexShader : kTriangleUniformVertexShader;
+
+    VkShaderModuleCreateInfo vertexShaderModuleCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+        .codeSize = vertexShaderCode.size,
+        .pCode = vertexShaderCode.code
     };
 
-    VK_CHECK_ERROR(vkBeginCommandBuffer(mCommandBuffer, &commandBufferBeginInfo));
+    VK_CHECK_ERROR(vkCreateShaderModule(mDevice,
+                                        &vertexShaderModuleCreateInfo,
+                                        mHostAllocator.callbacks(VK_OBJECT_TYPE_SHADER_MODULE),
+                                        &mVertexShaderModule));
 
-    for (auto swapchainImage: mSwapchainImages) {
-        // ================================================================================
-        // 10. VkImageLayout 변환
-        // ================================================================================
-        VkImageMemoryBarrier imageMemoryBarrierForPresentSwapchainImage{
-            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-            .srcAccessMask = 0,
-            .dstAccessMask = 0,
-            .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-            .newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
-            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-            .image = swapchainImage,
-            .subresourceRange = {
-                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-                .baseMipLevel = 0,
-                .levelCount = 1,
-                .baseArrayLayer = 0,
-                .layerCount = 1
+    VkShaderModuleCreateInfo fragmentShaderModuleCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+        .codeSize = fragmentShaderCode.size,
+        .pCode = fragmentShaderCode.code
+    };
+
+    VK_CHECK_ERROR(vkCreateShaderModule(mDevice,
+                                        &fragmentShaderModuleCreateInfo,
+                                        mHostAllocator.callbacks(VK_OBJECT_TYPE_SHADER_MODULE),
+                                        &mFragmentShaderModule));
+
+    VkShaderModuleCreateInfo fallbackFragmentShaderModuleCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+        .codeSize = kFallbackFragmentShader.size,
+        .pCode = kFallbackFragmentShader.code
+    };
+
+    VK_CHECK_ERROR(vkCreateShaderModule(mDevice,
+                                        &fallbackFragmentShaderModuleCreateInfo,
+                                        mHostAllocator.callbacks(VK_OBJECT_TYPE_SHADER_MODULE),
+                                        &mFallbackFragmentShaderModule));
+
+    // ================================================================================
+    // 17. VkTexture, VkDescriptorSetLayout, VkPipelineLayout 생성
+    // ================================================================================
+    // 삼각형마다 구분되도록 체크, 가로 줄무늬, 세로 줄무늬, 격자 무늬 텍스처를 만든다.
+    constexpr uint32_t kTextureSize = 64;
+    vector<uint32_t> pixels(kTextureSize * kTextureSize);
+    for (uint32_t i = 0; i != kTextureCount; ++i) {
+        for (uint32_t y = 0; y != kTextureSize; ++y) {
+            for (uint32_t x = 0; x != kTextureSize; ++x) {
+                array<bool, kTextureCount> patterns{
+                    (x / 8 + y / 8) % 2 == 0,
+                    (y / 8) % 2 == 0,
+                    (x / 8) % 2 == 0,
+                    (x / 8) % 2 == 0 || (y / 8) % 2 == 0
+                };
+                pixels[y * kTextureSize + x] = patterns[i] ? 0xffffffff : 0xff606060;
             }
+        }
+
+        mTextures.push_back(make_unique<VkTexture>(mHostAllocator,
+                                                   *mMemoryBudget,
+                                                   mDevice,
+                                                   *mUploader,
+                                                   VK_FORMAT_R8G8B8A8_UNORM,
+                                                   VkExtent2D{kTextureSize, kTextureSize},
+                                                   pixels.data(),
+                                                   sizeof(uint32_t) * pixels.size()));
+    }
+
+    VkSamplerCreateInfo samplerCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+        .magFilter = VK_FILTER_NEAREST,
+        .minFilter = VK_FILTER_LINEAR,
+        .mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST,
+        .addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+        .addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+        .addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+        .maxLod = VK_LOD_CLAMP_NONE
+    };
+
+    mSampler = mObjectCache->sampler(samplerCreateInfo);
+
+    // Bindless는 전역 세트 하나를 한 번만 바인딩하고 pooled는 draw마다 세트를 할당한다.
+    // Descriptor buffer는 세트 없이 디스크립터 바이트를 버퍼에 직접 복사한다.
+    if (mDescriptorMode == kBindlessDescriptors) {
+        mBindlessTable = make_unique<VkBindlessTable>(mHostAllocator, mDevice, *mObjectCache);
+        for (const auto &texture: mTextures) {
+            mBindlessTable->add(texture->imageView(), mSampler);
+        }
+        mTextureSetLayout = mBindlessTable->descriptorSetLayout();
+    } else if (mDescriptorMode == kDescriptorBuffer) {
+        mDescriptorBuffer = make_unique<VkDescriptorBuffer>(mHostAllocator,
+                                                            *mMemoryBudget,
+                                                            mDevice,
+                                                            *mObjectCache,
+                                                            descriptorBufferProperties,
+                                                            kFrameCount);
+        for (const auto &texture: mTextures) {
+            mDescriptorBuffer->addTexture(texture->imageView(), mSampler);
+        }
+        mTextureSetLayout = mDescriptorBuffer->descriptorSetLayout();
+    } else {
+        VkDescriptorSetLayoutBinding descriptorSetLayoutBinding{
+            .binding = 0,
+            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            .descriptorCount = 1,
+            .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT
         };
 
-        vkCmdPipelineBarrier(mCommandBuffer,
-                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                             VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-                             0,
-                             0,
-                             nullptr,
-                             0,
-                             nullptr,
-                             1,
-                             &imageMemoryBarrierForPresentSwapchainImage);
+        VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+            .bindingCount = 1,
+            .pBindings = &descriptorSetLayoutBinding
+        };
+
+        mTextureSetLayout = mObjectCache->descriptorSetLayout(descriptorSetLayoutCreateInfo);
     }
 
+    aout << "Descriptor Information ↓" << endl;
+    aout << setw(16) << left << " - Mode: "
+         << (mDescriptorMode == kBindlessDescriptors ? "Bindless" :
+             mDescriptorMode == kDescriptorBuffer ? "Descriptor Buffer" : "Pooled") << endl;
+    aout << setw(16) << left << " - Bindless: "
+         << (mBindlessEnabled ? "Supported" : "Not Supported") << endl;
+    aout << setw(16) << left << " - Buffer: "
+         << (mDescriptorBufferEnabled ? "Supported" : "Not Supported") << endl;
+    aout << setw(16) << left << " - Draw Data: "
+         << (mDrawData->path() == VkDrawData::kPushConstants ? "Push Constant" :
+             "Push Descriptor") << endl;
+
+    // Push constant 경로는 범위를, push descriptor 경로는 세트 1을 레이아웃에 추가한다.
+    vector<VkDescriptorSetLayout> setLayouts{mTextureSetLayout};
+    vector<VkPushConstantRange> pushConstantRanges;
+    if (mDrawData->path() == VkDrawData::kPushConstants) {
+        pushConstantRanges.push_back(mDrawData->pushConstantRange());
+    } else {
+        setLayouts.push_back(mDrawData->descriptorSetLayout());
+    }
+
+    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .setLayoutCount = static_cast<uint32_t>(setLayouts.size()),
+        .pSetLayouts = setLayouts.data(),
+        .pushConstantRangeCount = static_cast<uint32_t>(pushConstantRanges.size()),
+        .pPushConstantRanges = pushConstantRanges.data()
+    };
+
+    mPipelineLayout = mObjectCache->pipelineLayout(pipelineLayoutCreateInfo);
+
     // ================================================================================
-    // 11. VkCommandBuffer 기록 종료
+    // 18. VkPipeline 컴파일 요청
     // ================================================================================
-    VK_CHECK_ERROR(vkEndCommandBuffer(mCommandBuffer));
+    mJobSystem = make_unique<JobSystem>();
+    mPipelineManager = make_unique<VkPipelineManager>(mHostAllocator,
+                                                      mDevice,
+                                                      *mPipelineCache,
+                                                      *mJobSystem,
+                                                      mGraphicsPipelineLibraryEnabled);
+
+    auto hasStencil = mDepthAttachment->aspectMask() & VK_IMAGE_ASPECT_STENCIL_BIT;
+    VkGraphicsPipelineState pipelineState{
+        .flags = mDescriptorMode == kDescriptorBuffer ?
+                 VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT : 0u,
+        .vertexShaderModule = mVertexShaderModule,
+        .fragmentShaderModule = mFallbackFragmentShaderModule,
+        .vertexBindingDescriptions = {
+            VkVertexInputBindingDescription{
+                .binding = 0,
+                .stride = sizeof(Vertex),
+                .inputRate = VK_VERTEX_INPUT_RATE_VERTEX
+            },
+            VkVertexInputBindingDescription{
+                .binding = 1,
+                .stride = sizeof(Instance),
+                .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE
+            },
+            VkVertexInputBindingDescription{
+                .binding = 2,
+                .stride = sizeof(float),
+                .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE
+            }
+        },
+        .vertexAttributeDescriptions = {
+            VkVertexInputAttributeDescription{
+                .location = 0,
+                .binding = 0,
+                .format = VK_FORMAT_R32G32_SFLOAT,
+                .offset = offsetof(Vertex, position)
+            },
+            VkVertexInputAttributeDescription{
+                .location = 1,
+                .binding = 0,
+                .format = VK_FORMAT_R32G32B32_SFLOAT,
+                .offset = offsetof(Vertex, color)
+            },
+            VkVertexInputAttributeDescription{
+                .location = 2,
+                .binding = 1,
+                .format = VK_FORMAT_R32G32B32_SFLOAT,
+                .offset = offsetof(Instance, offset)
+            },
+            VkVertexInputAttributeDescription{
+                .location = 3,
+                .binding = 1,
+                .format = VK_FORMAT_R32_UINT,
+                .offset = offsetof(Instance, textureIndex)
+            },
+            VkVertexInputAttributeDescription{
+                .location = 4,
+                .binding = 2,
+                .format = VK_FORMAT_R32_SFLOAT,
+                .offset = 0
+            }
+        },
+        .layout = mPipelineLayout,
+        .renderPass = mRenderPass,
+        .colorFormat = mSwapchainFormat,
+        .depthFormat = mDepthFormat,
+        .stencilFormat = hasStencil ? mDepthFormat : VK_FORMAT_UNDEFINED
+    };
+
+    // 단색 fallback 파이프라인은 첫 프레임부터 필요하므로 여기서 완료를 기다린다.
+    mFallbackPipelineHandle = mPipelineManager->request(pipelineState);
+    mPipelineManager->wait(mFallbackPipelineHandle);
+
+    // 실제 파이프라인은 백그라운드에서 컴파일되고 render()는 완료 여부만 확인한다.
+    // 색상 모드는 specialization constant로 바꾸므로 하나의 SPIR-V에서 모든 변형을 만든다.
+    pipelineState.fragmentShaderModule = mFragmentShaderModule;
+    mShaderVariantCache = make_unique<VkShaderVariantCache>(*mPipelineManager, pipelineState);
+
+    mVariantCount = static_cast<uint32_t>(
+            clamp(getIntSetting("debug.practicevulkan.variants", 1), 1, 3));
+    for (uint32_t i = 0; i != mVariantCount; ++i) {
+        mShaderVariantCache->variant({i});
+    }
 
     // ================================================================================
-    // 12. VkCommandBuffer 제출
+    // 19. VkShaderEXT 생성
     // ================================================================================
-    VkSubmitInfo submitInfo{
-        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-        .commandBufferCount = 1,
-        .pCommandBuffers = &mCommandBuffer
-    };
+    if (mShaderObjectEnabled) {
+        VkShaderObjects::State shaderObjectState{
+            .vertexBindingDescriptions = {
+                VkVertexInputBindingDescription2EXT{
+                    .sType = VK_STRUCTURE_TYPE_VERTEX_INPUT_BINDING_DESCRIPTION_2_EXT,
+                    .binding = 0,
+                    .stride = sizeof(Vertex),
+                    .inputRate = VK_VERTEX_INPUT_RATE_VERTEX,
+                    .divisor = 1
+                },
+                VkVertexInputBindingDescription2EXT{
+                    .sType = VK_STRUCTURE_TYPE_VERTEX_INPUT_BINDING_DESCRIPTION_2_EXT,
+                    .binding = 1,
+                    .stride = sizeof(Instance),
+                    .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE,
+                    .divisor = 1
+                },
+                VkVertexInputBindingDescription2EXT{
+                    .sType = VK_STRUCTURE_TYPE_VERTEX_INPUT_BINDING_DESCRIPTION_2_EXT,
+                    .binding = 2,
+                    .stride = sizeof(float),
+                    .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE,
+                    .divisor = 1
+                }
+            },
+            .vertexAttributeDescriptions = {
+                VkVertexInputAttributeDescription2EXT{
+                    .sType = VK_STRUCTURE_TYPE_VERTEX_INPUT_ATTRIBUTE_DESCRIPTION_2_EXT,
+                    .location = 0,
+                    .binding = 0,
+                    .format = VK_FORMAT_R32G32_SFLOAT,
+                    .offset = offsetof(Vertex, position)
+                },
+                VkVertexInputAttributeDescription2EXT{
+                    .sType = VK_STRUCTURE_TYPE_VERTEX_INPUT_ATTRIBUTE_DESCRIPTION_2_EXT,
+                    .location = 1,
+                    .binding = 0,
+                    .format = VK_FORMAT_R32G32B32_SFLOAT,
+                    .offset = offsetof(Vertex, color)
+                },
+                VkVertexInputAttributeDescription2EXT{
+                    .sType = VK_STRUCTURE_TYPE_VERTEX_INPUT_ATTRIBUTE_DESCRIPTION_2_EXT,
+                    .location = 2,
+                    .binding = 1,
+                    .format = VK_FORMAT_R32G32B32_SFLOAT,
+                    .offset = offsetof(Instance, offset)
+                },
+                VkVertexInputAttributeDescription2EXT{
+                    .sType = VK_STRUCTURE_TYPE_VERTEX_INPUT_ATTRIBUTE_DESCRIPTION_2_EXT,
+                    .location = 3,
+                    .binding = 1,
+                    .format = VK_FORMAT_R32_UINT,
+                    .offset = offsetof(Instance, textureIndex)
+                },
+                VkVertexInputAttributeDescription2EXT{
+                    .sType = VK_STRUCTURE_TYPE_VERTEX_INPUT_ATTRIBUTE_DESCRIPTION_2_EXT,
+                    .location = 4,
+                    .binding = 2,
+                    .format = VK_FORMAT_R32_SFLOAT,
+                    .offset = 0
+                }
+            },
+            .setLayouts = setLayouts,
+            .pushConstantRanges = pushConstantRanges
+        };
+
+        mShaderObjects = make_unique<VkShaderObjects>(mHostAllocator,
+                                                      mDevice,
+                                                      vertexShaderCode,
+                                                      fragmentShaderCode,
+                                                      std::move(shaderObjectState));
+    }
 
-    VK_CHECK_ERROR(vkQueueSubmit(mQueue, 1, &submitInfo, VK_NULL_HANDLE));
-    VK_CHECK_ERROR(vkQueueWaitIdle(mQueue));
+    // 렌더링 경로는 설정으로 고르고 compare는 리포트마다 두 경로를 번갈아 측정한다.
+    auto renderPath = getStringSetting("debug.practicevulkan.render_path", "pipeline");
+    mRenderPathComparison = mShaderObjectEnabled && renderPath == "compare";
+    mShaderObjectPathActive = mShaderObjectEnabled && renderPath == "shader_object";
+    mProfiler->setLabel(mShaderObjectPathActive ? "Shader Object" : "Pipeline");
 
     // ================================================================================
-    // 13. VkFence 생성
+    // 20. 트랜스폼 계층, Vertex, Index, Instance VkBuffer 생성 및 업로드
     // ================================================================================
-    VkFenceCreateInfo fenceCreateInfo{
-        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+    const array<Vertex, 3> vertices{
+        Vertex{.position = {0.0f, -0.5f}, .color = {1.0f, 0.0f, 0.0f}},
+        Vertex{.position = {0.5f, 0.5f}, .color = {0.0f, 1.0f, 0.0f}},
+        Vertex{.position = {-0.5f, 0.5f}, .color = {0.0f, 0.0f, 1.0f}}
     };
 
-    VK_CHECK_ERROR(vkCreateFence(mDevice, &fenceCreateInfo, nullptr, &mFence));
+    const array<uint16_t, 3> indices{0, 1, 2};
+
+    // 격자는 루트 아래에 행 노드를, 행 노드 아래에 삼각형 노드를 두는 계층으로 만든다.
+    // 인스턴스의 위치와 크기는 매 프레임 월드 행렬에서 다시 채워진다.
+    auto columnCount = static_cast<uint32_t>(ceil(sqrt(static_cast<float>(mTriangleCount))));
+    auto rowCount = (mTriangleCount + columnCount - 1) / columnCount;
+    mCellSize = 2.0f / columnCount;
+
+    auto rootNode = mTransforms.add(TransformHierarchy::kNoParent, simdIdentity());
+    for (uint32_t i = 0; i != rowCount; ++i) {
+        mRowNodes.push_back(mTransforms.add(rootNode, rowTransform(i, 0.0f)));
+    }
+
+    auto cellScale = mTriangleCount == 1 ? 1.0f : mCellSize;
+    mInstances.resize(mTriangleCount);
+    for (uint32_t i = 0; i != mTriangleCount; ++i) {
+        auto local = simdMul(simdTranslation(-1.0f + mCellSize * (i % columnCount + 0.5f),
+                                             0.0f,
+                                             0.0f),
+                             simdScaling(cellScale, cellScale, 1.0f));
+        mObjectNodes.push_back(mTransforms.add(mRowNodes[i / columnCount], local));
+        mInstances[i].textureIndex = i % kTextureCount;
+        mFrustumCuller.add(0.0f, 0.0f, 0.0f, 0.0f);
+        mObjectRects.push_back({});
+    }
+    mFrustumCuller.setFrustum(FrustumCuller::orthographic(mCullRect.minX,
+                                                          mCullRect.minY,
+                                                          mCullRect.maxX,
+                                                          mCullRect.maxY,
+                                                          -1.0f,
+                                                          1.0f));
+
+    mVertexBuffer = make_unique<VkDeviceBuffer>(mHostAllocator,
+                                                *mMemoryBudget,
+                                                mDevice,
+                                                sizeof(vertices),
+                                                VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+                                                VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    mIndexBuffer = make_unique<VkDeviceBuffer>(mHostAllocator,
+                                               *mMemoryBudget,
+                                               mDevice,
+                                               sizeof(indices),
+                                               VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+                                               VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    // GPU 기반 제출에서는 컬링 셰이더도 인스턴스 버퍼를 읽는다.
+    auto submission = getStringSetting("debug.practicevulkan.submission", "cpu");
+    mGpuDrivenActive = mGpuDrivenEnabled && submission == "gpu";
+    // 텍스처를 인스턴스마다 고르는 것은 바인드리스 모드뿐이므로 다른 모드에서는 CPU 제출로 돌아간다.
+    if (mGpuDrivenActive && mDescriptorMode != kBindlessDescriptors) {
+        aout << "GPU submission disabled: requires bindless descriptors" << endl;
+        mGpuDrivenActive = false;
+    }
+    // 간접 드로우 한 번에 오브젝트 전부를 기록하므로 장치의 드로우 개수 한도를 넘으면 CPU 제출로 돌아간다.
+    auto maxDrawIndirectCount = physicalDeviceProperties.limits.maxDrawIndirectCount;
+    if (mGpuDrivenActive && mTriangleCount > maxDrawIndirectCount) {
+        aout << "GPU submission disabled: " << mTriangleCount
+             << " objects exceed maxDrawIndirectCount " << maxDrawIndirectCount << endl;
+        mGpuDrivenActive = false;
+    }
+    mBatchingActive = submission == "batched";
+
+    // 트랜스폼이 매 프레임 바뀌므로 인스턴스 버퍼는 프레임마다 영역을 나눠 쓰는 매핑된 버퍼이다.
+    // 컬링 셰이더가 dynamic offset으로 읽을 수 있도록 영역 크기를 정렬한다.
+    mInstanceFrameSize =
+            alignUp<VkDeviceSize>(sizeof(Instance) * mInstances.size(),
+                    physicalDeviceProperties.limits.minStorageBufferOffsetAlignment);
+    mInstanceBuffer = make_unique<VkDeviceBuffer>(mHostAllocator,
+                                                  *mMemoryBudget,
+                                                  mDevice,
+                                                  mInstanceFrameSize * kFrameCount,
+                                                  VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+                                                  VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                  VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    auto uploadTicket = mUploader->uploadBuffer(vertices.data(),
+                                                sizeof(vertices),
+                                                mVertexBuffer->buffer(),
+                                                0,
+                                                VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+                                                VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+    assert(uploadTicket);
+
+    uploadTicket = mUploader->uploadBuffer(indices.data(),
+                                           sizeof(indices),
+                                           mIndexBuffer->buffer(),
+                                           0,
+                                           VK_ACCESS_INDEX_READ_BIT,
+                                           VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+    assert(uploadTicket);
 
     // ================================================================================
-    // 13. Semaphore 생성
+    // 21. 애니메이션 채널, VkBuffer 생성
     // ================================================================================
-    VkSemaphoreCreateInfo semaphoreCreateInfo{
-        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
-    };
+    // 삼각형마다 크기가 맥동하는 위상 채널을 두고, 마지막 네 채널은 clear 색상에 사용한다.
+    // 결과는 프레임마다 나눠 쓰는 매핑된 버퍼에 바로 기록되고 정점 입력으로 읽힌다.
+    for (uint32_t i = 0; i != mTriangleCount; ++i) {
+        mAnimation.add(static_cast<float>(i) / mTriangleCount,
+                       0.25f + 0.125f * (i % 7),
+                       0.0f,
+                       1.0f);
+    }
+    mClearColorChannel = mAnimation.channelCount();
+    for (auto value: mClearColorValue.float32) {
+        mAnimation.add(value, 0.6f, 0.0f, 1.0f);
+    }
+
+    // all은 모든 채널과 트랜스폼을, transforms는 흔들리는 행만, none은 아무것도 움직이지 않는다.
+    auto animation = getStringSetting("debug.practicevulkan.animation", "all");
+    mAnimationMode = animation == "none" ? kAnimateNone :
+                     animation == "transforms" ? kAnimateTransforms : kAnimateAll;
+
+    mAnimationBuffer = make_unique<VkDeviceBuffer>(mHostAllocator,
+                                                   *mMemoryBudget,
+                                                   mDevice,
+                                                   sizeof(float) * mAnimation.channelCount() *
+                                                   kFrameCount,
+                                                   VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                   VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    // 실행 간 비교가 필요하면 fixed로 고정 간격 시뮬레이션을 사용한다.
+    // 단계 하나가 프레임 간격 상한보다 길면 진행할 수 없으므로 10Hz 이상으로 제한한다.
+    auto clockMode = getStringSetting("debug.practicevulkan.clock", "variable");
+    auto fixedStepRate = max(10, getIntSetting("debug.practicevulkan.fixed_step_hz", 60));
+    mFrameClock = make_unique<FrameClock>(clockMode == "fixed" ? FrameClock::kFixedStep
+                                                               : FrameClock::kVariableStep,
+                                          chrono::nanoseconds(1000000000 / fixedStepRate),
+                                          chrono::milliseconds(kMaxFrameDeltaMs));
+    aout << setw(16) << left << " - Clock: "
+         << (mFrameClock->mode() == FrameClock::kFixedStep ? "Fixed" : "Variable") << endl;
+    aout << setw(16) << left << " - Animation: "
+         << (mAnimationMode == kAnimateAll ? "All"
+                                           : (mAnimationMode == kAnimateTransforms ? "Transforms"
+                                                                                   : "None"))
+         << endl;
+    aout << setw(16) << left << " - Present: "
+         << (mIncrementalPresentEnabled ? "Incremental" : "Full") << endl;
+    aout << setw(16) << left << " - Pacing: "
+         << (mFramePacer->isDisplayTimingEnabled() ? "Display Timing" : "Estimated")
+         << (mFramePacer->isPresentWaitEnabled() ? " + Present Wait" : "") << endl;
+
+    // ================================================================================
+    // 22. GPU 컬링, 배치 생성
+    // ================================================================================
+    if (mGpuDrivenActive) {
+        mGpuCulling = make_unique<VkGpuCulling>(mHostAllocator,
+                                                *mMemoryBudget,
+                                                mDevice,
+                                                *mObjectCache,
+                                                *mPipelineCache,
+                                                kCullComputeShader,
+                                                mInstanceBuffer->buffer(),
+                                                mTriangleCount,
+                                                static_cast<uint32_t>(indices.size()),
+                                                mDrawIndirectCountEnabled);
+    }
 
-    VK_CHECK_ERROR(vkCreateSemaphore(mDevice, &semaphoreCreateInfo, nullptr, &mImageAcquisitionSemaphore));
-    VK_CHECK_ERROR(vkCreateSemaphore(mDevice, &semaphoreCreateInfo, nullptr, &mRenderCompletionSemaphore));
+    // 인스턴스 데이터를 매 프레임 정렬된 순서로 다시 채우므로 프레임마다 영역을 따로 갖는다.
+    if (mBatchingActive) {
+        mDrawBatcher = make_unique<VkDrawBatcher>(mHostAllocator,
+                                                  *mMemoryBudget,
+                                                  mDevice,
+                                                  sizeof(Instance),
+                                                  mTriangleCount,
+                                                  kFrameCount);
+    }
+
+    aout << setw(16) << left << " - Submission: "
+         << (mGpuDrivenActive ? (mDrawIndirectCountEnabled ? "GPU (indirect count)" : "GPU")
+                              : (mBatchingActive ? "Batched" : "CPU")) << endl;
+
+    // 설정한 개수의 무작위 구로 한 스레드와 JobSystem에서의 컬링 처리량을 측정한다.
+    auto benchmarkObjectCount = getIntSetting("debug.practicevulkan.cull_benchmark", 0);
+    if (benchmarkObjectCount > 0) {
+        auto objectCount = static_cast<uint32_t>(benchmarkObjectCount);
+        auto singleThreaded = FrustumCuller::benchmark(nullptr, objectCount, kBenchmarkIterations);
+        auto jobSystem = FrustumCuller::benchmark(mJobSystem.get(),
+                                                  objectCount,
+                                                  kBenchmarkIterations);
+        aout << "Frustum Culling Benchmark ↓" << endl;
+        aout << setw(16) << left << " - Objects: " << objectCount << endl;
+        aout << setw(16) << left << " - 1 Thread: " << singleThreaded / 1e6 << " M/s" << endl;
+        aout << setw(16) << left << " - Job System: " << jobSystem / 1e6 << " M/s ("
+             << mJobSystem->threadCount() + 1 << " threads)" << endl;
+    }
+
+    mHostAllocator.report();
+    mMemoryBudget->report();
 }
 
 VkRenderer::~VkRenderer() {
-    vkDestroySemaphore(mDevice, mImageAcquisitionSemaphore, nullptr);
-    vkDestroySemaphore(mDevice, mRenderCompletionSemaphore, nullptr);
-    vkDestroyFence(mDevice, mFence, nullptr);
-    vkFreeCommandBuffers(mDevice, mCommandPool, 1, &mCommandBuffer);
-    vkDestroyCommandPool(mDevice, mCommandPool, nullptr);
-    vkDestroySwapchainKHR(mDevice, mSwapchain, nullptr);
-    vkDestroySurfaceKHR(mInstance, mSurface, nullptr);
-    vkDestroyDevice(mDevice, nullptr);
-    vkDestroyInstance(mInstance, nullptr);
+    VK_CHECK_ERROR(vkDeviceWaitIdle(mDevice));
+    mHostAllocator.report();
+
+    aout << "Frame Information ↓" << endl;
+    aout << setw(16) << left << " - Rendered: " << mRenderedFrameCount << endl;
+    aout << setw(16) << left << " - Skipped: " << mSkippedFrameCount << endl;
+    mFramePacer->report();
+
+    mVertexBuffer.reset();
+    mIndexBuffer.reset();
+    mGpuCulling.reset();
+    mDrawBatcher.reset();
+    mAnimationBuffer.reset();
+    mInstanceBuffer.reset();
+    mBindlessTable.reset();
+    mDescriptorBuffer.reset();
+    mDrawData.reset();
+    mTextures.clear();
+    mShaderObjects.reset();
+    mShaderVariantCache->report();
+    mShaderVariantCache.reset();
+    mPipelineManager->report();
+    mPipelineManager.reset();
+    mJobSystem.reset();
+    vkDestroyShaderModule(mDevice,
+                          mVertexShaderModule,
+                          mHostAllocator.callbacks(VK_OBJECT_TYPE_SHADER_MODULE));
+    vkDestroyShaderModule(mDevice,
+                          mFragmentShaderModule,
+                          mHostAllocator.callbacks(VK_OBJECT_TYPE_SHADER_MODULE));
+    vkDestroyShaderModule(mDevice,
+                          mFallbackFragmentShaderModule,
+                          mHostAllocator.callbacks(VK_OBJECT_TYPE_SHADER_MODULE));
+    mPipelineCache.reset();
+    mProfiler.reset();
+    mUploader.reset();
+    mDepthAttachment.reset();
+    mMemoryBudget.reset();
+    for (auto &frame: mFrames) {
+        frame.descriptorAllocator.reset();
+        vkDestroySemaphore(mDevice,
+                           frame.imageAcquisitionSemaphore,
+                           mHostAllocator.callbacks(VK_OBJECT_TYPE_SEMAPHORE));
+        vkDestroySemaphore(mDevice,
+                           frame.renderCompletionSemaphore,
+                           mHostAllocator.callbacks(VK_OBJECT_TYPE_SEMAPHORE));
+        vkDestroyFence(mDevice, frame.fence, mHostAllocator.callbacks(VK_OBJECT_TYPE_FENCE));
+        vkFreeCommandBuffers(mDevice, mCommandPool, 1, &frame.commandBuffer);
+    }
+    vkDestroyCommandPool(mDevice,
+                         mCommandPool,
+                         mHostAllocator.callbacks(VK_OBJECT_TYPE_COMMAND_POOL));
+    for (auto framebuffer: mFramebuffers) {
+        vkDestroyFramebuffer(mDevice,
+                             framebuffer,
+                             mHostAllocator.callbacks(VK_OBJECT_TYPE_FRAMEBUFFER));
+    }
+    mObjectCache->report();
+    mObjectCache.reset();
+    for (auto imageView: mSwapchainImageViews) {
+        vkDestroyImageView(mDevice, imageView, mHostAllocator.callbacks(VK_OBJECT_TYPE_IMAGE_VIEW));
+    }
+    vkDestroySwapchainKHR(mDevice,
+                          mSwapchain,
+                          mHostAllocator.callbacks(VK_OBJECT_TYPE_SWAPCHAIN_KHR));
+    vkDestroySurfaceKHR(mInstance, mSurface, mHostAllocator.callbacks(VK_OBJECT_TYPE_SURFACE_KHR));
+    vkDestroyDevice(mDevice, mHostAllocator.callbacks(VK_OBJECT_TYPE_DEVICE));
+    vkDestroyInstance(mInstance, mHostAllocator.callbacks(VK_OBJECT_TYPE_INSTANCE));
 }
 
 void VkRenderer::render() {
     // ================================================================================
-    // 1. 화면에 출력할 수 있는 VkImage 얻기
+    // 0. 메모리 사용량 및 예산 갱신
+    // ================================================================================
+    mMemoryBudget->sample();
+
+    // ================================================================================
+    // 1. 같은 프레임 자원을 사용한 이전 제출이 끝날 때까지 기다리기
+    // ================================================================================
+    auto &frame = mFrames[mFrameIndex];
+    VK_CHECK_ERROR(vkWaitForFences(mDevice, 1, &frame.fence, VK_TRUE, UINT64_MAX));
+
+    // ================================================================================
+    // 2. 출력 간격 맞추기
+    // ================================================================================
+    // 출력 큐가 줄어들 때까지 기다리고, 출력 피드백을 읽고, 이번 프레임이 슬롯보다 너무 일찍
+    // 나갈 것 같으면 시작을 늦춘다. 애니메이션은 기다린 뒤의 시각으로 갱신해야 화면에 나가는
+    // 시점과 어긋나지 않는다.
+    mFramePacer->wait();
+
+    // ================================================================================
+    // 3. 애니메이션, 트랜스폼 갱신
+    // ================================================================================
+    updateAnimation();
+    updateTransforms();
+
+    // ================================================================================
+    // 4. 바뀐 것이 없으면 프레임 건너뛰기
+    // ================================================================================
+    // 마지막으로 출력한 이미지가 화면에 남아 있으므로 acquire, 제출, 출력을 모두 생략한다.
+    // 펜스를 리셋하기 전에 돌아가야 다음 호출에서 같은 프레임 자원을 그대로 쓸 수 있다.
+    if (!isFrameChanged()) {
+        ++mSkippedFrameCount;
+        mFrameSkipped = true;
+        return;
+    }
+    ++mRenderedFrameCount;
+    mFrameSkipped = false;
+    VK_CHECK_ERROR(vkResetFences(mDevice, 1, &frame.fence));
+
+    // ================================================================================
+    // 5. 화면에 출력할 수 있는 VkImage 얻기
     // ================================================================================
     uint32_t swapchainImageIndex;
     VK_CHECK_ERROR(vkAcquireNextImageKHR(mDevice,
                                          mSwapchain,
                                          UINT64_MAX,
-                                         mImageAcquisitionSemaphore,
-                                         mFence,
+                                         frame.imageAcquisitionSemaphore,
+                                         VK_NULL_HANDLE,
                                          &swapchainImageIndex));
-    auto swapchainImage = mSwapchainImages[swapchainImageIndex];
 
     // ================================================================================
-    // 2. VkFence 기다린 후 초기화
+    // 6. VkCommandBuffer, 디스크립터 풀 초기화
     // ================================================================================
-    VK_CHECK_ERROR(vkWaitForFences(mDevice, 1, &mFence, VK_TRUE, UINT64_MAX));
-    VK_CHECK_ERROR(vkResetFences(mDevice, 1, &mFence));
-
-    // ================================================================================
-    // 3. VkCommandBuffer 초기화
-    // ================================================================================
-    vkResetCommandBuffer(mCommandBuffer, 0);
+    vkResetCommandBuffer(frame.commandBuffer, 0);
+    frame.descriptorAllocator->reset();
+    // 매핑된 링 버퍼들(디스크립터 버퍼, draw 데이터, 배치 인스턴스)은 프레임마다 영역을 하나씩
+    // 가진다. beginFrame()은 그 영역을 다시 쓰므로 이 프레임의 펜스를 기다린 뒤에만 호출한다.
+    if (mDescriptorBuffer) {
+        mDescriptorBuffer->beginFrame(mFrameIndex);
+    }
+    mDrawData->beginFrame(mFrameIndex);
 
     // ================================================================================
-    // 8. VkCommandBuffer 기록 시작
+    // 7. VkCommandBuffer 기록 시작
     // ================================================================================
     VkCommandBufferBeginInfo commandBufferBeginInfo{
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
         .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
     };
 
-    VK_CHECK_ERROR(vkBeginCommandBuffer(mCommandBuffer, &commandBufferBeginInfo));
+    VK_CHECK_ERROR(vkBeginCommandBuffer(frame.commandBuffer, &commandBufferBeginInfo));
+    mProfiler->begin(frame.commandBuffer);
 
     // ================================================================================
-    // 9. VkImageLayout 변환
+    // 8. 업로드 제출 및 소유권 획득(Acquire)
     // ================================================================================
-    VkImageMemoryBarrier imageMemoryBarrierForClearColorImage{
-        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-        .srcAccessMask = VK_ACCESS_NONE,
-        .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
-        .oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
-        .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-        .image = swapchainImage,
-        .subresourceRange = {
-            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-            .baseMipLevel = 0,
-            .levelCount = 1,
-            .baseArrayLayer = 0,
-            .layerCount = 1
-        }
-    };
-
-    vkCmdPipelineBarrier(mCommandBuffer,
-                         VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                         VK_PIPELINE_STAGE_TRANSFER_BIT,
-                         0,
-                         0,
-                         nullptr,
-                         0,
-                         nullptr,
-                         1,
-                         &imageMemoryBarrierForClearColorImage);
+    auto uploaded = mUploader->submit(&mUploadSubmission);
+    // 어떤 텍스처나 버퍼가 바뀌었는지 추적하지 않으므로 화면 전체가 바뀐 것으로 처리한다.
+    if (uploaded) {
+        mDamageTracker->addFull();
+    }
+    if (uploaded && (!mUploadSubmission.bufferMemoryBarriers.empty() ||
+                     !mUploadSubmission.imageMemoryBarriers.empty())) {
+        vkCmdPipelineBarrier(frame.commandBuffer,
+                             mUploadSubmission.dstStageMask,
+                             mUploadSubmission.dstStageMask,
+                             0,
+                             0,
+                             nullptr,
+                             static_cast<uint32_t>(mUploadSubmission.bufferMemoryBarriers.size()),
+                             mUploadSubmission.bufferMemoryBarriers.data(),
+                             static_cast<uint32_t>(mUploadSubmission.imageMemoryBarriers.size()),
+                             mUploadSubmission.imageMemoryBarriers.data());
+    }
 
     // ================================================================================
-    // 10. Clear 색상 갱신
+    // 9. GPU 컬링 (렌더 패스 밖에서 indirect 명령 생성)
     // ================================================================================
-    for (auto i = 0; i != 4; ++i) {
-        mClearColorValue.float32[i] = fmodf(mClearColorValue.float32[i] + 0.01, 1.0);
+    if (mGpuDrivenActive) {
+        mGpuCulling->record(frame.commandBuffer,
+                            mCullRect,
+                            static_cast<uint32_t>(instanceOffset()));
     }
 
     // ================================================================================
-    // 11. VkImage 색상 초기화
+    // 10. 렌더링 시작 (load op으로 색상 초기화)
     // ================================================================================
-    VkImageSubresourceRange imageSubresourceRange{
-        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-        .baseMipLevel = 0,
-        .levelCount = 1,
-        .baseArrayLayer = 0,
-        .layerCount = 1
-    };
-
-    vkCmdClearColorImage(mCommandBuffer,
-                         swapchainImage,
-                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                         &mClearColorValue,
-                         1,
-                         &imageSubresourceRange);
+    beginRendering(frame.commandBuffer, swapchainImageIndex);
 
     // ================================================================================
-    // 12. VkImageLayout 변환
+    // 11. 삼각형 그리기
     // ================================================================================
-    VkImageMemoryBarrier imageMemoryBarrierForPresentSwapchainImage{
-        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
-        .dstAccessMask = 0,
-        .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        .newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
-        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-        .image = swapchainImage,
-        .subresourceRange = {
-            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-            .baseMipLevel = 0,
-            .levelCount = 1,
-            .baseArrayLayer = 0,
-            .layerCount = 1
-        }
+    array<VkBuffer, 3> vertexBuffers{
+        mVertexBuffer->buffer(),
+        mInstanceBuffer->buffer(),
+        mAnimationBuffer->buffer()
     };
+    array<VkDeviceSize, 3> vertexBufferOffsets{0, instanceOffset(), animationOffset()};
+    vkCmdBindVertexBuffers(frame.commandBuffer,
+                           0,
+                           static_cast<uint32_t>(vertexBuffers.size()),
+                           vertexBuffers.data(),
+                           vertexBufferOffsets.data());
+    vkCmdBindIndexBuffer(frame.commandBuffer, mIndexBuffer->buffer(), 0, VK_INDEX_TYPE_UINT16);
+
+    // Bindless는 전역 세트를 한 번만 바인딩하고 셰이더가 인스턴스 데이터로 텍스처를 고른다.
+    if (mDescriptorMode == kBindlessDescriptors) {
+        auto descriptorSet = mBindlessTable->descriptorSet();
+        vkCmdBindDescriptorSets(frame.commandBuffer,
+                                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                mPipelineLayout,
+                                0,
+                                1,
+                                &descriptorSet,
+                                0,
+                                nullptr);
+    } else if (mDescriptorMode == kDescriptorBuffer) {
+        mDescriptorBuffer->bind(frame.commandBuffer);
+    }
 
-    vkCmdPipelineBarrier(mCommandBuffer,
-                         VK_PIPELINE_STAGE_TRANSFER_BIT,
-                         VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-                         0,
-                         0,
-                         nullptr,
-                         0,
-                         nullptr,
-                         1,
-                         &imageMemoryBarrierForPresentSwapchainImage);
+    if (mShaderObjectPathActive) {
+        mShaderObjects->bind(frame.commandBuffer, mSwapchainExtent);
+    } else {
+        setViewportAndScissor(frame.commandBuffer);
+    }
+
+    auto drawCount = mTriangleCount;
+    if (mGpuDrivenActive) {
+        // Indirect 명령은 파이프라인 하나로 그리므로 첫 번째 변형만 사용한다.
+        if (!mShaderObjectPathActive) {
+            bindVariant(frame, 0);
+        }
+        drawCulled(frame);
+        drawCount = 1;
+    } else if (mBatchingActive) {
+        drawCount = drawBatched(frame);
+    } else if (mShaderObjectPathActive) {
+        for (uint32_t i = 0; i != mTriangleCount; ++i) {
+            bindTexture(frame, i % kTextureCount);
+            pushDrawData(frame, i);
+            vkCmdDrawIndexed(frame.commandBuffer, 3, 1, 0, 0, i);
+        }
+    } else {
+        // 파이프라인 교체를 줄이기 위해 같은 변형을 사용하는 삼각형을 모아서 그린다.
+        for (uint32_t variant = 0; variant != mVariantCount; ++variant) {
+            bindVariant(frame, variant);
+
+            for (auto i = variant; i < mTriangleCount; i += mVariantCount) {
+                bindTexture(frame, i % kTextureCount);
+                pushDrawData(frame, i);
+                vkCmdDrawIndexed(frame.commandBuffer, 3, 1, 0, 0, i);
+            }
+        }
+    }
+
+    // ================================================================================
+    // 12. 렌더링 종료
+    // ================================================================================
+    endRendering(frame.commandBuffer, swapchainImageIndex);
 
     // ================================================================================
-    // 9. VkCommandBuffer 기록 종료
+    // 13. VkCommandBuffer 기록 종료
     // ================================================================================
-    VK_CHECK_ERROR(vkEndCommandBuffer(mCommandBuffer));
+    auto reported = mProfiler->end(frame.commandBuffer, drawCount, mTriangleCount);
+    if (reported && mRenderPathComparison) {
+        mShaderObjectPathActive = !mShaderObjectPathActive;
+        mProfiler->setLabel(mShaderObjectPathActive ? "Shader Object" : "Pipeline");
+    }
+    VK_CHECK_ERROR(vkEndCommandBuffer(frame.commandBuffer));
 
     // ================================================================================
-    // 10. VkCommandBuffer 제출
+    // 14. VkCommandBuffer 제출
     // ================================================================================
-    VkPipelineStageFlags waitDstStageMask{VK_PIPELINE_STAGE_TRANSFER_BIT};
+    array<VkSemaphore, 2> waitSemaphores{frame.imageAcquisitionSemaphore};
+    array<VkPipelineStageFlags, 2> waitDstStageMasks{
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
+    };
+    uint32_t waitSemaphoreCount = 1;
+    if (uploaded) {
+        waitSemaphores[waitSemaphoreCount] = mUploadSubmission.semaphore;
+        waitDstStageMasks[waitSemaphoreCount] = mUploadSubmission.dstStageMask;
+        ++waitSemaphoreCount;
+    }
+
     VkSubmitInfo submitInfo{
         .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-        .waitSemaphoreCount = 1,
-        .pWaitSemaphores = &mImageAcquisitionSemaphore,
-        .pWaitDstStageMask = &waitDstStageMask,
+        .waitSemaphoreCount = waitSemaphoreCount,
+        .pWaitSemaphores = waitSemaphores.data(),
+        .pWaitDstStageMask = waitDstStageMasks.data(),
         .commandBufferCount = 1,
-        .pCommandBuffers = &mCommandBuffer,
+        .pCommandBuffers = &frame.commandBuffer,
         .signalSemaphoreCount = 1,
-        .pSignalSemaphores = &mRenderCompletionSemaphore
+        .pSignalSemaphores = &frame.renderCompletionSemaphore
     };
 
-    VK_CHECK_ERROR(vkQueueSubmit(mQueue, 1, &submitInfo, VK_NULL_HANDLE));
+    VK_CHECK_ERROR(vkQueueSubmit(mQueue, 1, &submitInfo, frame.fence));
 
     // ================================================================================
-    // 11. VkImage 화면에 출력
+    // 15. VkImage 화면에 출력
     // ================================================================================
+    // 바뀐 사각형이 없으면 rectangleCount가 0이 되어 전체가 바뀐 것으로 처리된다.
+    void *presentInfoNext = nullptr;
+    const auto &damageRectangles = mDamageTracker->rectangles();
+    VkPresentRegionKHR presentRegion{
+        .rectangleCount = static_cast<uint32_t>(damageRectangles.size()),
+        .pRectangles = damageRectangles.data()
+    };
+    VkPresentRegionsKHR presentRegions{
+        .sType = VK_STRUCTURE_TYPE_PRESENT_REGIONS_KHR,
+        .swapchainCount = 1,
+        .pRegions = &presentRegion
+    };
+    if (mIncrementalPresentEnabled) {
+        vkChain(&presentInfoNext, &presentRegions);
+    }
+
+    // 출력 ID를 붙이고, 마지막 실제 출력 시각에서 간격만큼 떨어진 시각보다 일찍 나가지 않게 한다.
+    mFramePacer->chainPresentInfo(&presentInfoNext);
+
     VkPresentInfoKHR presentInfo{
         .sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+        .pNext = presentInfoNext,
         .waitSemaphoreCount = 1,
-        .pWaitSemaphores = &mRenderCompletionSemaphore,
+        .pWaitSemaphores = &frame.renderCompletionSemaphore,
         .swapchainCount = 1,
         .pSwapchains = &mSwapchain,
         .pImageIndices = &swapchainImageIndex
     };
 
     VK_CHECK_ERROR(vkQueuePresentKHR(mQueue, &presentInfo));
+    mDamageTracker->reset();
+    mFramePacer->presented();
+
+    mFrameIndex = (mFrameIndex + 1) % kFrameCount;
+}
+
+void VkRenderer::bindTexture(Frame &frame, uint32_t textureIndex) {
+    if (mDescriptorMode == kBindlessDescriptors) {
+        return;
+    }
+
+    if (mDescriptorMode == kDescriptorBuffer) {
+        mDescriptorBuffer->bindTexture(frame.commandBuffer, mPipelineLayout, textureIndex);
+        return;
+    }
+
+    // Draw마다 세트를 할당하고 갱신한다. 할당한 세트는 프레임 풀을 초기화할 때 한 번에 반환된다.
+    auto descriptorSet = frame.descriptorAllocator->allocate(mTextureSetLayout);
+
+    VkDescriptorImageInfo descriptorImageInfo{
+        .sampler = mSampler,
+        .imageView = mTextures[textureIndex]->imageView(),
+        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+    };
+
+    VkWriteDescriptorSet writeDescriptorSet{
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstSet = descriptorSet,
+        .dstBinding = 0,
+        .dstArrayElement = 0,
+        .descriptorCount = 1,
+        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+        .pImageInfo = &descriptorImageInfo
+    };
+
+    vkUpdateDescriptorSets(mDevice, 1, &writeDescriptorSet, 0, nullptr);
+    vkCmdBindDescriptorSets(frame.commandBuffer,
+                            VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            mPipelineLayout,
+                            0,
+                            1,
+                            &descriptorSet,
+                            0,
+                            nullptr);
+}
+
+void VkRenderer::pushDrawData(Frame &frame, uint32_t drawIndex) {
+    // Clear 색상에서 draw마다 다른 채널 순서로 틴트를 만든다. 스택 값만 사용하므로 할당이 없다.
+    DrawData drawData{.tint = {0.0f, 0.0f, 0.0f, 1.0f}};
+    for (uint32_t i = 0; i != 3; ++i) {
+        drawData.tint[i] = 0.5f + 0.5f * mClearColorValue.float32[(i + drawIndex) % 3];
+    }
+
+    mDrawData->push(frame.commandBuffer, mPipelineLayout, &drawData);
+}
+
+int VkRenderer::pollTimeout() const {
+    // 방금 프레임을 그렸으면 다음 프레임도 바뀔 가능성이 높으므로 기다리지 않는다.
+    if (!mFrameSkipped) {
+        return 0;
+    }
+
+    // 고정 단계 클락은 다음 단계가 생길 때까지 아무것도 바뀌지 않는다.
+    if (mAnimationMode != kAnimateNone && !mFrameClock->isPaused()) {
+        auto timeout = chrono::ceil<chrono::milliseconds>(mFrameClock->untilNextStep());
+        return static_cast<int>(timeout.count());
+    }
+
+    // 움직이는 것이 없으면 입력이나 앱 명령이 올 때까지 블록한다.
+    return -1;
+}
+
+void VkRenderer::pause() {
+    mFrameClock->pause();
+}
+
+void VkRenderer::resume() {
+    mFrameClock->resume();
+}
+
+void VkRenderer::updateAnimation() {
+    // 프레임 클락의 단계만큼 진행하므로 속도가 프레임 레이트와 무관하다.
+    // 채널 애니메이션이 꺼져 있으면 시간을 진행하지 않고 결과만 기록한다.
+    mFrameClock->tick();
+    auto stepCount = mFrameClock->stepCount();
+    auto stepDelta = mAnimationMode == kAnimateAll ? mFrameClock->stepDelta() : 0.0f;
+    for (uint32_t i = 1; i < stepCount; ++i) {
+        mAnimation.update(stepDelta);
+    }
+
+    // 진행할 단계가 없어도 이번 프레임 영역은 채워야 하므로 마지막 갱신에서 결과를 기록한다.
+    // 배치 경로는 인스턴스 순서가 바뀌므로 drawBatched()가 정렬된 순서로 다시 채운다.
+    mAnimation.update(stepCount ? stepDelta : 0.0f,
+                      mBatchingActive ? nullptr : animationData());
+    for (uint32_t i = 0; i != 4; ++i) {
+        mClearColorValue.float32[i] = mAnimation.value(mClearColorChannel + i);
+    }
+
+    // Clear 색상과 틴트가 바뀌면 화면 전체가 바뀐다.
+    if (stepCount && mAnimationMode == kAnimateAll) {
+        mDamageTracker->addFull();
+    }
+}
+
+bool VkRenderer::isFrameChanged() {
+    // 다시 그려야 하는 이유마다 바뀐 영역을 같이 기록하고 바뀐 영역이 있을 때만 그린다.
+    // 그래야 다시 그린 프레임이 출력 영역 밖에서 바뀌는 일이 없다.
+
+    // 백그라운드에서 컴파일한 파이프라인이 발행되면 폴백으로 그린 draw의 결과가 바뀐다.
+    // 발행 직전에 기록한 프레임이 폴백을 썼을 수 있으므로 한 프레임 더 그린다.
+    // 어느 draw에 쓰였는지 모르므로 화면 전체가 바뀐 것으로 처리한다.
+    auto pipelinesPending = mPipelineManager->pendingCount() != 0;
+    if (pipelinesPending || mPipelinesPending) {
+        mDamageTracker->addFull();
+    }
+    mPipelinesPending = pipelinesPending;
+
+    // 기록을 기다리는 복사는 이번 프레임에 제출되어 어떤 텍스처나 버퍼든 바꿀 수 있다.
+    if (mUploader->hasPendingCopies()) {
+        mDamageTracker->addFull();
+    }
+
+    // 렌더 경로 비교는 측정을 위해 매 프레임 그린다. 결과가 같으므로 바뀐 영역은 없다.
+    return !mDamageTracker->isEmpty() || mRenderPathComparison;
+}
+
+VkRect2D VkRenderer::screenRect(float x, float y, float radius) const {
+    // NDC의 원을 감싸는 픽셀 사각형. 래스터화 오차를 덮도록 한 픽셀씩 넓힌다.
+    auto halfWidth = 0.5f * mSwapchainExtent.width;
+    auto halfHeight = 0.5f * mSwapchainExtent.height;
+    auto minX = static_cast<int32_t>(floorf((x - radius + 1.0f) * halfWidth)) - 1;
+    auto minY = static_cast<int32_t>(floorf((y - radius + 1.0f) * halfHeight)) - 1;
+    auto maxX = static_cast<int32_t>(ceilf((x + radius + 1.0f) * halfWidth)) + 1;
+    auto maxY = static_cast<int32_t>(ceilf((y + radius + 1.0f) * halfHeight)) + 1;
+    return {
+        .offset = {minX, minY},
+        .extent = {static_cast<uint32_t>(maxX - minX), static_cast<uint32_t>(maxY - minY)}
+    };
+}
+
+Float4x4 VkRenderer::rowTransform(uint32_t row, float shift) const {
+    return simdTranslation(shift, -1.0f + mCellSize * (row + 0.5f), 0.0f);
+}
+
+void VkRenderer::updateTransforms() {
+    // ================================================================================
+    // 1. 움직이는 행의 로컬 트랜스폼 갱신
+    // ================================================================================
+    // 일부 행만 좌우로 흔들리므로 나머지 서브트리는 월드 행렬을 다시 계산하지 않는다.
+    // 시간이 흐르지 않았으면 로컬 트랜스폼도 그대로이므로 갱신하지 않는다.
+    if (mAnimationMode != kAnimateNone && mFrameClock->stepCount()) {
+        auto time = static_cast<float>(mFrameClock->time());
+        for (uint32_t i = 0; i < mRowNodes.size(); i += kAnimatedRowInterval) {
+            auto shift = 0.25f * mCellSize * sinf(3.14159265f * time + static_cast<float>(i));
+            mTransforms.setLocal(mRowNodes[i], rowTransform(i, shift));
+        }
+    }
+    mTransforms.update();
+
+    // ================================================================================
+    // 2. 월드 행렬로 인스턴스 데이터 기록
+    // ================================================================================
+    // 배치 경로는 CPU 사본을 정렬해서 복사하므로 매핑된 버퍼 대신 사본에 쓴다.
+    auto instances = mBatchingActive ? mInstances.data() : instanceData();
+    for (uint32_t i = 0; i != mTriangleCount; ++i) {
+        const auto &world = mTransforms.world(mObjectNodes[i]);
+        array<float, 4> axis;
+        array<float, 4> translation;
+        simdStore(axis.data(), world.columns[0]);
+        simdStore(translation.data(), world.columns[3]);
+
+        instances[i] = {
+            .offset = {translation[0], translation[1]},
+            .scale = sqrtf(axis[0] * axis[0] + axis[1] * axis[1]),
+            .textureIndex = mInstances[i].textureIndex
+        };
+
+        // 정점이 [-0.5, 0.5] 범위에 있으므로 경계 구의 반지름은 scale * sqrt(0.5)이다.
+        auto radius = instances[i].scale * 0.70710678f;
+        mFrustumCuller.set(i, translation[0], translation[1], 0.0f, radius);
+
+        // 움직였으면 이전 위치와 새 위치를 모두 다시 그려야 한다.
+        if (mTransforms.isChanged(mObjectNodes[i])) {
+            auto rect = screenRect(translation[0], translation[1], radius);
+            mDamageTracker->add(mObjectRects[i]);
+            mDamageTracker->add(rect);
+            mObjectRects[i] = rect;
+        }
+    }
+}
+
+VkDeviceSize VkRenderer::instanceOffset() const {
+    return mInstanceFrameSize * mFrameIndex;
+}
+
+VkRenderer::Instance *VkRenderer::instanceData() const {
+    auto mappedData = static_cast<uint8_t *>(mInstanceBuffer->mappedData());
+    return reinterpret_cast<Instance *>(mappedData + instanceOffset());
+}
+
+VkDeviceSize VkRenderer::animationOffset() const {
+    return sizeof(float) * mAnimation.channelCount() * mFrameIndex;
+}
+
+float *VkRenderer::animationData() const {
+    auto mappedData = static_cast<uint8_t *>(mAnimationBuffer->mappedData());
+    return reinterpret_cast<float *>(mappedData + animationOffset());
+}
+
+void VkRenderer::bindVariant(Frame &frame, uint32_t variant) {
+    // 컴파일이 끝나지 않았으면 fallback 파이프라인으로 그린다.
+    auto pipeline = mPipelineManager->pipeline(mShaderVariantCache->variant({variant}));
+    if (pipeline == VK_NULL_HANDLE) {
+        pipeline = mPipelineManager->pipeline(mFallbackPipelineHandle);
+    }
+    vkCmdBindPipeline(frame.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+}
+
+uint32_t VkRenderer::drawBatched(Frame &frame) {
+    // ================================================================================
+    // 1. 컬링 후 보이는 오브젝트마다 정렬 키 생성
+    // ================================================================================
+    // 메시는 삼각형 하나뿐이다. Bindless도 텍스처로 나눠야 셰이더의 인덱스가 draw 안에서
+    // 일정하다. nonuniformEXT 없이 draw 안에서 바뀌는 인덱스로 접근하면 정의되지 않은 동작이다.
+    const auto &visibles = mFrustumCuller.cull(mJobSystem.get());
+    mDrawBatcher->beginFrame(mFrameIndex);
+    for (auto i: visibles) {
+        auto variant = mShaderObjectPathActive ? 0 : i % mVariantCount;
+        auto material = mInstances[i].textureIndex;
+        mDrawBatcher->add(VkDrawBatcher::makeKey(variant, 0, material), &mInstances[i]);
+    }
+
+    // ================================================================================
+    // 2. 정렬된 인스턴스 데이터 바인딩
+    // ================================================================================
+    const auto &batches = mDrawBatcher->build();
+    auto instanceBuffer = mDrawBatcher->buffer();
+    auto instanceBufferOffset = mDrawBatcher->offset();
+    vkCmdBindVertexBuffers(frame.commandBuffer, 1, 1, &instanceBuffer, &instanceBufferOffset);
+
+    // 애니메이션 위상도 정렬된 인스턴스 순서로 옮긴다.
+    auto phases = animationData();
+    for (uint32_t i = 0; i != visibles.size(); ++i) {
+        phases[i] = mAnimation.value(visibles[mDrawBatcher->sourceIndex(i)]);
+    }
+
+    // ================================================================================
+    // 3. 배치마다 인스턴스 draw 기록
+    // ================================================================================
+    uint32_t boundVariant = UINT32_MAX;
+    for (uint32_t i = 0; i != batches.size(); ++i) {
+        const auto &batch = batches[i];
+        auto variant = VkDrawBatcher::pipeline(batch.key);
+        if (!mShaderObjectPathActive && variant != boundVariant) {
+            bindVariant(frame, variant);
+            boundVariant = variant;
+        }
+        // 배치 순서는 컬링 결과에 따라 바뀌므로 틴트는 순서가 아닌 키로 정한다.
+        // Bindless는 bindTexture()가 아무것도 하지 않고 셰이더가 같은 인덱스를 읽는다.
+        auto material = VkDrawBatcher::material(batch.key);
+        bindTexture(frame, material);
+        pushDrawData(frame, variant + material);
+        vkCmdDrawIndexed(frame.commandBuffer, 3, batch.instanceCount, 0, 0, batch.firstInstance);
+    }
+
+    return static_cast<uint32_t>(batches.size());
+}
+
+void VkRenderer::drawCulled(Frame &frame) {
+    // 오브젝트별 상태는 인스턴스 번호로 구분되므로 CPU는 오브젝트 수와 무관하게 한 번만 기록한다.
+    // 바인드리스 모드에서만 활성화되므로 텍스처도 셰이더가 인스턴스의 텍스처 인덱스로 고른다.
+    pushDrawData(frame, 0);
+    mGpuCulling->draw(frame.commandBuffer);
+}
+
+void VkRenderer::setViewportAndScissor(VkCommandBuffer commandBuffer) {
+    VkViewport viewport{
+        .x = 0.0f,
+        .y = 0.0f,
+        .width = static_cast<float>(mSwapchainExtent.width),
+        .height = static_cast<float>(mSwapchainExtent.height),
+        .minDepth = 0.0f,
+        .maxDepth = 1.0f
+    };
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+    VkRect2D scissor{
+        .offset = {0, 0},
+        .extent = mSwapchainExtent
+    };
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+}
+
+void VkRenderer::beginRendering(VkCommandBuffer commandBuffer, uint32_t swapchainImageIndex) {
+    array<VkClearValue, 2> clearValues{
+        VkClearValue{.color = mClearColorValue},
+        VkClearValue{.depthStencil = {.depth = 1.0f, .stencil = 0}}
+    };
+
+    VkRect2D renderArea{
+        .offset = {0, 0},
+        .extent = mSwapchainExtent
+    };
+
+    if (!mDynamicRenderingEnabled) {
+        VkRenderPassBeginInfo renderPassBeginInfo{
+            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+            .renderPass = mRenderPass,
+            .framebuffer = mFramebuffers[swapchainImageIndex],
+            .renderArea = renderArea,
+            .clearValueCount = static_cast<uint32_t>(clearValues.size()),
+            .pClearValues = clearValues.data()
+        };
+
+        vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+        return;
+    }
+
+    // 이전 내용은 필요 없으므로 UNDEFINED에서 attachment layout으로 변환한다.
+    array<VkImageMemoryBarrier, 2> imageMemoryBarriers{
+        VkImageMemoryBarrier{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_NONE,
+            .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+            .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = mSwapchainImages[swapchainImageIndex],
+            .subresourceRange = {
+                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                .baseMipLevel = 0,
+                .levelCount = 1,
+                .baseArrayLayer = 0,
+                .layerCount = 1
+            }
+        },
+        VkImageMemoryBarrier{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = mDepthAttachment->image(),
+            .subresourceRange = {
+                .aspectMask = mDepthAttachment->aspectMask(),
+                .baseMipLevel = 0,
+                .levelCount = 1,
+                .baseArrayLayer = 0,
+                .layerCount = 1
+            }
+        }
+    };
+
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                         VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                         VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         static_cast<uint32_t>(imageMemoryBarriers.size()),
+                         imageMemoryBarriers.data());
+
+    VkRenderingAttachmentInfo colorAttachmentInfo{
+        .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+        .imageView = mSwapchainImageViews[swapchainImageIndex],
+        .imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+        .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+        .clearValue = clearValues[0]
+    };
+
+    VkRenderingAttachmentInfo depthAttachmentInfo{
+        .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+        .imageView = mDepthAttachment->imageView(),
+        .imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+        .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+        .storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+        .clearValue = clearValues[1]
+    };
+
+    auto hasStencil = mDepthAttachment->aspectMask() & VK_IMAGE_ASPECT_STENCIL_BIT;
+    VkRenderingInfo renderingInfo{
+        .sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+        .renderArea = renderArea,
+        .layerCount = 1,
+        .colorAttachmentCount = 1,
+        .pColorAttachments = &colorAttachmentInfo,
+        .pDepthAttachment = &depthAttachmentInfo,
+        .pStencilAttachment = hasStencil ? &depthAttachmentInfo : nullptr
+    };
+
+    mCmdBeginRendering(commandBuffer, &renderingInfo);
 }
+
+void VkRenderer::endRendering(VkCommandBuffer commandBuffer, uint32_t swapchainImageIndex) {
+    if (!mDynamicRenderingEnabled) {
+        vkCmdEndRenderPass(commandBuffer);
+        return;
+    }
+
+    mCmdEndRendering(commandBuffer);
+
+    VkImageMemoryBarrier imageMemoryBarrierForPresentSwapchainImage{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_NONE,
+        .oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        .newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = mSwapchainImages[swapchainImageIndex],
+        .subresourceRange = {
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .baseMipLevel = 0,
+            .levelCount = 1,
+            .baseArrayLayer = 0,
+            .layerCount = 1
+        }
+    };
+
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         1,
+                         &imageMemoryBarrierForPresentSwapchainImage);
+}
\ No newline at end of file
@@ -20,28 +20,193 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
 #include <vulkan/vulkan.h>
 
+#include "AnimationSystem.h"
+#include "FrameClock.h"
+#include "FrustumCuller.h"
+#include "JobSystem.h"
+#include "TransformHierarchy.h"
+#include "VkAttachment.h"
+#include "VkBindlessTable.h"
+#include "VkDamageTracker.h"
+#include "VkDescriptorAllocator.h"
+#include "VkDescriptorBuffer.h"
+#include "VkHostAllocator.h"
+#include "VkDeviceBuffer.h"
+#include "VkDrawBatcher.h"
+#include "VkDrawData.h"
+#include "VkFramePacer.h"
+#include "VkGpuCulling.h"
+#include "VkMemoryBudget.h"
+#include "VkObjectCache.h"
+#include "VkPipelineCacheStore.h"
+#include "VkPipelineManager.h"
+#include "VkProfiler.h"
+#include "VkShaderObjects.h"
+#include "VkShaderVariantCache.h"
+#include "VkTexture.h"
+#include "VkUploader.h"
+
 class VkRenderer {
 public:
-    explicit VkRenderer(ANativeWindow* window);
+    VkRenderer(ANativeWindow* window, const std::string &dataPath);
     ~VkRenderer();
 
+    // 이전 프레임과 같은 결과가 나오면 acquire, 제출, 출력 없이 돌아간다.
     void render();
+    // 다음 render()까지 이벤트를 기다려도 되는 시간(ms). -1이면 이벤트가 올 때까지 기다린다.
+    int pollTimeout() const;
+    // 포커스를 잃은 동안 애니메이션 시간이 흐르지 않도록 프레임 클락을 멈춘다.
+    void pause();
+    void resume();
+
+    VkUploader &uploader() { return *mUploader; }
+    VkMemoryBudget &memoryBudget() { return *mMemoryBudget; }
 
 private:
+    static constexpr VkDeviceSize kStagingRingSize = 16 * 1024 * 1024;
+    static constexpr uint32_t kFrameCount = 2;
+    static constexpr uint32_t kTextureCount = 4;
+    static constexpr uint32_t kMaxFrameDeltaMs = 100;
+    static constexpr uint32_t kAnimatedRowInterval = 4;
+    static constexpr uint32_t kBenchmarkIterations = 100;
+
+    enum AnimationMode {
+        kAnimateAll,
+        kAnimateTransforms,
+        kAnimateNone
+    };
+
+    enum DescriptorMode {
+        kPooledDescriptors,
+        kBindlessDescriptors,
+        kDescriptorBuffer
+    };
+
+    struct Instance {
+        float offset[2];
+        float scale;
+        uint32_t textureIndex;
+    };
+
+    // CPU가 GPU보다 앞서서 기록할 수 있도록 프레임마다 따로 갖는 자원
+    struct Frame {
+        VkCommandBuffer commandBuffer;
+        VkFence fence;
+        VkSemaphore imageAcquisitionSemaphore;
+        VkSemaphore renderCompletionSemaphore;
+        std::unique_ptr<VkDescriptorAllocator> descriptorAllocator;
+    };
+
+    void beginRendering(VkCommandBuffer commandBuffer, uint32_t swapchainImageIndex);
+    void endRendering(VkCommandBuffer commandBuffer, uint32_t swapchainImageIndex);
+    void bindTexture(Frame &frame, uint32_t textureIndex);
+    void pushDrawData(Frame &frame, uint32_t drawIndex);
+    void updateAnimation();
+    bool isFrameChanged();
+    VkRect2D screenRect(float x, float y, float radius) const;
+    Float4x4 rowTransform(uint32_t row, float shift) const;
+    void updateTransforms();
+    VkDeviceSize instanceOffset() const;
+    Instance *instanceData() const;
+    VkDeviceSize animationOffset() const;
+    float *animationData() const;
+    void bindVariant(Frame &frame, uint32_t variant);
+    void drawCulled(Frame &frame);
+    uint32_t drawBatched(Frame &frame);
+    void setViewportAndScissor(VkCommandBuffer commandBuffer);
+
+    VkHostAllocator mHostAllocator;
     VkInstance mInstance;
     VkPhysicalDevice mPhysicalDevice;
     uint32_t mQueueFamilyIndex;
     VkDevice mDevice;
     VkQueue mQueue;
+    uint32_t mTransferQueueFamilyIndex;
+    VkQueue mTransferQueue;
+    bool mDynamicRenderingEnabled;
+    bool mGraphicsPipelineLibraryEnabled;
+    bool mShaderObjectEnabled;
+    bool mBindlessEnabled;
+    bool mDescriptorBufferEnabled;
+    bool mPushDescriptorEnabled;
+    bool mIncrementalPresentEnabled;
+    bool mDisplayTimingEnabled;
+    bool mPresentWaitEnabled;
+    bool mGpuDrivenEnabled;
+    bool mDrawIndirectCountEnabled;
+    PFN_vkCmdBeginRendering mCmdBeginRendering = nullptr;
+    PFN_vkCmdEndRendering mCmdEndRendering = nullptr;
     VkSurfaceKHR mSurface;
     VkSwapchainKHR mSwapchain;
     std::vector<VkImage> mSwapchainImages;
+    VkFormat mSwapchainFormat;
+    VkExtent2D mSwapchainExtent;
+    std::unique_ptr<VkDamageTracker> mDamageTracker;
+    std::unique_ptr<VkFramePacer> mFramePacer;
+    VkFormat mDepthFormat;
+    std::unique_ptr<VkAttachment> mDepthAttachment;
+    std::vector<VkImageView> mSwapchainImageViews;
+    VkRenderPass mRenderPass = VK_NULL_HANDLE;
+    std::vector<VkFramebuffer> mFramebuffers;
     VkCommandPool mCommandPool;
-    VkCommandBuffer mCommandBuffer;
-    VkFence mFence;
+    std::array<Frame, kFrameCount> mFrames;
+    uint32_t mFrameIndex = 0;
+    bool mFrameSkipped = false;
+    bool mPipelinesPending = true;
+    uint64_t mRenderedFrameCount = 0;
+    uint64_t mSkippedFrameCount = 0;
     VkClearColorValue mClearColorValue{.float32{0.6431, 0.7765, 0.2235, 1.0}};
-    VkSemaphore mImageAcquisitionSemaphore;
-    VkSemaphore mRenderCompletionSemaphore;
+    std::unique_ptr<VkMemoryBudget> mMemoryBudget;
+    std::unique_ptr<VkPipelineCacheStore> mPipelineCache;
+    std::unique_ptr<VkObjectCache> mObjectCache;
+    std::unique_ptr<VkUploader> mUploader;
+    VkUploader::Submission mUploadSubmission;
+    std::unique_ptr<VkProfiler> mProfiler;
+    VkShaderModule mVertexShaderModule;
+    VkShaderModule mFragmentShaderModule;
+    VkShaderModule mFallbackFragmentShaderModule;
+    std::vector<std::unique_ptr<VkTexture>> mTextures;
+    VkSampler mSampler;
+    VkDescriptorSetLayout mTextureSetLayout;
+    std::unique_ptr<VkBindlessTable> mBindlessTable;
+    std::unique_ptr<VkDescriptorBuffer> mDescriptorBuffer;
+    DescriptorMode mDescriptorMode;
+    std::unique_ptr<VkDrawData> mDrawData;
+    VkPipelineLayout mPipelineLayout;
+    std::unique_ptr<JobSystem> mJobSystem;
+    std::unique_ptr<VkPipelineManager> mPipelineManager;
+    VkPipelineManager::Handle mFallbackPipelineHandle;
+    std::unique_ptr<VkShaderVariantCache> mShaderVariantCache;
+    uint32_t mVariantCount;
+    std::unique_ptr<VkShaderObjects> mShaderObjects;
+    bool mShaderObjectPathActive;
+    bool mRenderPathComparison;
+    std::unique_ptr<VkDeviceBuffer> mVertexBuffer;
+    std::unique_ptr<VkDeviceBuffer> mIndexBuffer;
+    std::unique_ptr<VkDeviceBuffer> mInstanceBuffer;
+    VkDeviceSize mInstanceFrameSize;
+    uint32_t mTriangleCount;
+    std::vector<Instance> mInstances;
+    float mCellSize;
+    TransformHierarchy mTransforms;
+    std::vector<uint32_t> mRowNodes;
+    std::vector<uint32_t> mObjectNodes;
+    FrustumCuller mFrustumCuller;
+    std::vector<VkRect2D> mObjectRects;
+    bool mBatchingActive;
+    std::unique_ptr<VkDrawBatcher> mDrawBatcher;
+    AnimationSystem mAnimation;
+    AnimationMode mAnimationMode;
+    uint32_t mClearColorChannel;
+    std::unique_ptr<VkDeviceBuffer> mAnimationBuffer;
+    std::unique_ptr<FrameClock> mFrameClock;
+    bool mGpuDrivenActive;
+    std::unique_ptr<VkGpuCulling> mGpuCulling;
+    VkGpuCulling::Rect mCullRect{-1.0f, -1.0f, 1.0f, 1.0f};
 };
\ No newline at end of file
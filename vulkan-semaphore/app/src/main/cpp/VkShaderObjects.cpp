@@ -0,0 +1,211 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <array>
+#include <cassert>
+
+#include "VkShaderObjects.h"
+#include "VkUtil.h"
+
+using namespace std;
+
+VkShaderObjects::VkShaderObjects(VkHostAllocator &hostAllocator,
+                                 VkDevice device,
+                                 const VkShaderCode &vertexShaderCode,
+                                 const VkShaderCode &fragmentShaderCode,
+                                 State state)
+        : mHostAllocator(hostAllocator),
+          mDevice(device),
+          mState(std::move(state)) {
+    // ================================================================================
+    // 1. 함수 포인터 얻기
+    // ================================================================================
+    mCreateShaders = vkGetDeviceProc<PFN_vkCreateShadersEXT>(mDevice, {"vkCreateShadersEXT"});
+    mDestroyShader = vkGetDeviceProc<PFN_vkDestroyShaderEXT>(mDevice, {"vkDestroyShaderEXT"});
+    mCmdBindShaders = vkGetDeviceProc<PFN_vkCmdBindShadersEXT>(mDevice, {"vkCmdBindShadersEXT"});
+    mCmdSetViewportWithCount = vkGetDeviceProc<PFN_vkCmdSetViewportWithCount>(
+            mDevice, {"vkCmdSetViewportWithCount", "vkCmdSetViewportWithCountEXT"});
+    mCmdSetScissorWithCount = vkGetDeviceProc<PFN_vkCmdSetScissorWithCount>(
+            mDevice, {"vkCmdSetScissorWithCount", "vkCmdSetScissorWithCountEXT"});
+    mCmdSetRasterizerDiscardEnable = vkGetDeviceProc<PFN_vkCmdSetRasterizerDiscardEnable>(
+            mDevice, {"vkCmdSetRasterizerDiscardEnable", "vkCmdSetRasterizerDiscardEnableEXT"});
+    mCmdSetVertexInput = vkGetDeviceProc<PFN_vkCmdSetVertexInputEXT>(
+            mDevice, {"vkCmdSetVertexInputEXT"});
+    mCmdSetPrimitiveTopology = vkGetDeviceProc<PFN_vkCmdSetPrimitiveTopology>(
+            mDevice, {"vkCmdSetPrimitiveTopology", "vkCmdSetPrimitiveTopologyEXT"});
+    mCmdSetPrimitiveRestartEnable = vkGetDeviceProc<PFN_vkCmdSetPrimitiveRestartEnable>(
+            mDevice, {"vkCmdSetPrimitiveRestartEnable", "vkCmdSetPrimitiveRestartEnableEXT"});
+    mCmdSetRasterizationSamples = vkGetDeviceProc<PFN_vkCmdSetRasterizationSamplesEXT>(
+            mDevice, {"vkCmdSetRasterizationSamplesEXT"});
+    mCmdSetSampleMask = vkGetDeviceProc<PFN_vkCmdSetSampleMaskEXT>(
+            mDevice, {"vkCmdSetSampleMaskEXT"});
+    mCmdSetAlphaToCoverageEnable = vkGetDeviceProc<PFN_vkCmdSetAlphaToCoverageEnableEXT>(
+            mDevice, {"vkCmdSetAlphaToCoverageEnableEXT"});
+    mCmdSetPolygonMode = vkGetDeviceProc<PFN_vkCmdSetPolygonModeEXT>(
+            mDevice, {"vkCmdSetPolygonModeEXT"});
+    mCmdSetCullMode = vkGetDeviceProc<PFN_vkCmdSetCullMode>(
+            mDevice, {"vkCmdSetCullMode", "vkCmdSetCullModeEXT"});
+    mCmdSetFrontFace = vkGetDeviceProc<PFN_vkCmdSetFrontFace>(
+            mDevice, {"vkCmdSetFrontFace", "vkCmdSetFrontFaceEXT"});
+    mCmdSetDepthTestEnable = vkGetDeviceProc<PFN_vkCmdSetDepthTestEnable>(
+            mDevice, {"vkCmdSetDepthTestEnable", "vkCmdSetDepthTestEnableEXT"});
+    mCmdSetDepthWriteEnable = vkGetDeviceProc<PFN_vkCmdSetDepthWriteEnable>(
+            mDevice, {"vkCmdSetDepthWriteEnable", "vkCmdSetDepthWriteEnableEXT"});
+    mCmdSetDepthCompareOp = vkGetDeviceProc<PFN_vkCmdSetDepthCompareOp>(
+            mDevice, {"vkCmdSetDepthCompareOp", "vkCmdSetDepthCompareOpEXT"});
+    mCmdSetDepthBoundsTestEnable = vkGetDeviceProc<PFN_vkCmdSetDepthBoundsTestEnable>(
+            mDevice, {"vkCmdSetDepthBoundsTestEnable", "vkCmdSetDepthBoundsTestEnableEXT"});
+    mCmdSetDepthBiasEnable = vkGetDeviceProc<PFN_vkCmdSetDepthBiasEnable>(
+            mDevice, {"vkCmdSetDepthBiasEnable", "vkCmdSetDepthBiasEnableEXT"});
+    mCmdSetStencilTestEnable = vkGetDeviceProc<PFN_vkCmdSetStencilTestEnable>(
+            mDevice, {"vkCmdSetStencilTestEnable", "vkCmdSetStencilTestEnableEXT"});
+    mCmdSetColorBlendEnable = vkGetDeviceProc<PFN_vkCmdSetColorBlendEnableEXT>(
+            mDevice, {"vkCmdSetColorBlendEnableEXT"});
+    mCmdSetColorWriteMask = vkGetDeviceProc<PFN_vkCmdSetColorWriteMaskEXT>(
+            mDevice, {"vkCmdSetColorWriteMaskEXT"});
+    assert(mCreateShaders && mDestroyShader && mCmdBindShaders);
+
+    // ================================================================================
+    // 2. VkShaderEXT 생성
+    // ================================================================================
+    // 두 셰이더를 연결해서 생성하면 드라이버가 스테이지 간 최적화를 할 수 있다.
+    array<VkShaderCreateInfoEXT, 2> shaderCreateInfos{
+        VkShaderCreateInfoEXT{
+            .sType = VK_STRUCTURE_TYPE_SHADER_CREATE_INFO_EXT,
+            .flags = VK_SHADER_CREATE_LINK_STAGE_BIT_EXT,
+            .stage = VK_SHADER_STAGE_VERTEX_BIT,
+            .nextStage = VK_SHADER_STAGE_FRAGMENT_BIT,
+            .codeType = VK_SHADER_CODE_TYPE_SPIRV_EXT,
+            .codeSize = vertexShaderCode.size,
+            .pCode = vertexShaderCode.code,
+            .pName = "main",
+            .setLayoutCount = static_cast<uint32_t>(mState.setLayouts.size()),
+            .pSetLayouts = mState.setLayouts.data(),
+            .pushConstantRangeCount = static_cast<uint32_t>(mState.pushConstantRanges.size()),
+            .pPushConstantRanges = mState.pushConstantRanges.data()
+        },
+        VkShaderCreateInfoEXT{
+            .sType = VK_STRUCTURE_TYPE_SHADER_CREATE_INFO_EXT,
+            .flags = VK_SHADER_CREATE_LINK_STAGE_BIT_EXT,
+            .stage = VK_SHADER_STAGE_FRAGMENT_BIT,
+            .codeType = VK_SHADER_CODE_TYPE_SPIRV_EXT,
+            .codeSize = fragmentShaderCode.size,
+            .pCode = fragmentShaderCode.code,
+            .pName = "main",
+            .setLayoutCount = static_cast<uint32_t>(mState.setLayouts.size()),
+            .pSetLayouts = mState.setLayouts.data(),
+            .pushConstantRangeCount = static_cast<uint32_t>(mState.pushConstantRanges.size()),
+            .pPushConstantRanges = mState.pushConstantRanges.data()
+        }
+    };
+
+    array<VkShaderEXT, 2> shaders{};
+    VK_CHECK_ERROR(mCreateShaders(mDevice,
+                                  static_cast<uint32_t>(shaderCreateInfos.size()),
+                                  shaderCreateInfos.data(),
+                                  mHostAllocator.callbacks(VK_OBJECT_TYPE_SHADER_EXT),
+                                  shaders.data()));
+    mVertexShader = shaders[0];
+    mFragmentShader = shaders[1];
+}
+
+VkShaderObjects::~VkShaderObjects() {
+    mDestroyShader(mDevice, mVertexShader, mHostAllocator.callbacks(VK_OBJECT_TYPE_SHADER_EXT));
+    mDestroyShader(mDevice, mFragmentShader, mHostAllocator.callbacks(VK_OBJECT_TYPE_SHADER_EXT));
+}
+
+void VkShaderObjects::bind(VkCommandBuffer commandBuffer, VkExtent2D extent) {
+    // ================================================================================
+    // 1. 셰이더 바인딩
+    // ================================================================================
+    // 사용하지 않는 스테이지도 VK_NULL_HANDLE로 명시적으로 바인딩한다.
+    array<VkShaderStageFlagBits, 5> stages{
+        VK_SHADER_STAGE_VERTEX_BIT,
+        VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT,
+        VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT,
+        VK_SHADER_STAGE_GEOMETRY_BIT,
+        VK_SHADER_STAGE_FRAGMENT_BIT
+    };
+    array<VkShaderEXT, 5> shaders{
+        mVertexShader,
+        VK_NULL_HANDLE,
+        VK_NULL_HANDLE,
+        VK_NULL_HANDLE,
+        mFragmentShader
+    };
+    mCmdBindShaders(commandBuffer,
+                    static_cast<uint32_t>(stages.size()),
+                    stages.data(),
+                    shaders.data());
+
+    // ================================================================================
+    // 2. 파이프라인이 가지고 있던 상태를 모두 dynamic state로 설정
+    // ================================================================================
+    VkViewport viewport{
+        .x = 0.0f,
+        .y = 0.0f,
+        .width = static_cast<float>(extent.width),
+        .height = static_cast<float>(extent.height),
+        .minDepth = 0.0f,
+        .maxDepth = 1.0f
+    };
+    mCmdSetViewportWithCount(commandBuffer, 1, &viewport);
+
+    VkRect2D scissor{
+        .offset = {0, 0},
+        .extent = extent
+    };
+    mCmdSetScissorWithCount(commandBuffer, 1, &scissor);
+
+    mCmdSetVertexInput(commandBuffer,
+                       static_cast<uint32_t>(mState.vertexBindingDescriptions.size()),
+                       mState.vertexBindingDescriptions.data(),
+                       static_cast<uint32_t>(mState.vertexAttributeDescriptions.size()),
+                       mState.vertexAttributeDescriptions.data());
+    mCmdSetPrimitiveTopology(commandBuffer, mState.topology);
+    mCmdSetPrimitiveRestartEnable(commandBuffer, VK_FALSE);
+
+    mCmdSetRasterizerDiscardEnable(commandBuffer, VK_FALSE);
+    mCmdSetPolygonMode(commandBuffer, VK_POLYGON_MODE_FILL);
+    mCmdSetCullMode(commandBuffer, mState.cullMode);
+    mCmdSetFrontFace(commandBuffer, VK_FRONT_FACE_COUNTER_CLOCKWISE);
+    mCmdSetDepthBiasEnable(commandBuffer, VK_FALSE);
+
+    VkSampleMask sampleMask = ~0u;
+    mCmdSetRasterizationSamples(commandBuffer, VK_SAMPLE_COUNT_1_BIT);
+    mCmdSetSampleMask(commandBuffer, VK_SAMPLE_COUNT_1_BIT, &sampleMask);
+    mCmdSetAlphaToCoverageEnable(commandBuffer, VK_FALSE);
+
+    mCmdSetDepthTestEnable(commandBuffer, mState.depthTestEnable);
+    mCmdSetDepthWriteEnable(commandBuffer, mState.depthWriteEnable);
+    mCmdSetDepthCompareOp(commandBuffer, mState.depthCompareOp);
+    mCmdSetDepthBoundsTestEnable(commandBuffer, VK_FALSE);
+    mCmdSetStencilTestEnable(commandBuffer, VK_FALSE);
+
+    VkBool32 colorBlendEnable = VK_FALSE;
+    VkColorComponentFlags colorWriteMask = VK_COLOR_COMPONENT_R_BIT |
+                                           VK_COLOR_COMPONENT_G_BIT |
+                                           VK_COLOR_COMPONENT_B_BIT |
+                                           VK_COLOR_COMPONENT_A_BIT;
+    mCmdSetColorBlendEnable(commandBuffer, 0, 1, &colorBlendEnable);
+    mCmdSetColorWriteMask(commandBuffer, 0, 1, &colorWriteMask);
+}
@@ -0,0 +1,96 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKSHADEROBJECTS_H
+#define PRACTICE_VULKAN_VKSHADEROBJECTS_H
+
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "VkHostAllocator.h"
+#include "VkShaders.h"
+
+/*!
+ * Linked vertex and fragment VkShaderEXT pair from VK_EXT_shader_object.
+ *
+ * No pipeline object exists, so bind() records every piece of state a pipeline would have
+ * baked in as dynamic state. Shader objects only work with dynamic rendering.
+ */
+class VkShaderObjects {
+public:
+    struct State {
+        std::vector<VkVertexInputBindingDescription2EXT> vertexBindingDescriptions;
+        std::vector<VkVertexInputAttributeDescription2EXT> vertexAttributeDescriptions;
+        std::vector<VkDescriptorSetLayout> setLayouts;
+        std::vector<VkPushConstantRange> pushConstantRanges;
+        VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        VkCullModeFlags cullMode = VK_CULL_MODE_NONE;
+        VkBool32 depthTestEnable = VK_TRUE;
+        VkBool32 depthWriteEnable = VK_TRUE;
+        VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+    };
+
+    VkShaderObjects(VkHostAllocator &hostAllocator,
+                    VkDevice device,
+                    const VkShaderCode &vertexShaderCode,
+                    const VkShaderCode &fragmentShaderCode,
+                    State state);
+    ~VkShaderObjects();
+
+    VkShaderObjects(const VkShaderObjects &) = delete;
+    VkShaderObjects &operator=(const VkShaderObjects &) = delete;
+
+    void bind(VkCommandBuffer commandBuffer, VkExtent2D extent);
+
+private:
+    VkHostAllocator &mHostAllocator;
+    VkDevice mDevice;
+    State mState;
+    VkShaderEXT mVertexShader;
+    VkShaderEXT mFragmentShader;
+
+    PFN_vkCreateShadersEXT mCreateShaders;
+    PFN_vkDestroyShaderEXT mDestroyShader;
+    PFN_vkCmdBindShadersEXT mCmdBindShaders;
+    PFN_vkCmdSetViewportWithCount mCmdSetViewportWithCount;
+    PFN_vkCmdSetScissorWithCount mCmdSetScissorWithCount;
+    PFN_vkCmdSetRasterizerDiscardEnable mCmdSetRasterizerDiscardEnable;
+    PFN_vkCmdSetVertexInputEXT mCmdSetVertexInput;
+    PFN_vkCmdSetPrimitiveTopology mCmdSetPrimitiveTopology;
+    PFN_vkCmdSetPrimitiveRestartEnable mCmdSetPrimitiveRestartEnable;
+    PFN_vkCmdSetRasterizationSamplesEXT mCmdSetRasterizationSamples;
+    PFN_vkCmdSetSampleMaskEXT mCmdSetSampleMask;
+    PFN_vkCmdSetAlphaToCoverageEnableEXT mCmdSetAlphaToCoverageEnable;
+    PFN_vkCmdSetPolygonModeEXT mCmdSetPolygonMode;
+    PFN_vkCmdSetCullMode mCmdSetCullMode;
+    PFN_vkCmdSetFrontFace mCmdSetFrontFace;
+    PFN_vkCmdSetDepthTestEnable mCmdSetDepthTestEnable;
+    PFN_vkCmdSetDepthWriteEnable mCmdSetDepthWriteEnable;
+    PFN_vkCmdSetDepthCompareOp mCmdSetDepthCompareOp;
+    PFN_vkCmdSetDepthBoundsTestEnable mCmdSetDepthBoundsTestEnable;
+    PFN_vkCmdSetDepthBiasEnable mCmdSetDepthBiasEnable;
+    PFN_vkCmdSetStencilTestEnable mCmdSetStencilTestEnable;
+    PFN_vkCmdSetColorBlendEnableEXT mCmdSetColorBlendEnable;
+    PFN_vkCmdSetColorWriteMaskEXT mCmdSetColorWriteMask;
+};
+
+#endif //PRACTICE_VULKAN_VKSHADEROBJECTS_H
@@ -0,0 +1,84 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstring>
+#include <iomanip>
+
+#include "VkShaderVariantCache.h"
+#include "Hash.h"
+#include "AndroidOut.h"
+
+using namespace std;
+
+VkShaderVariantCache::VkShaderVariantCache(VkPipelineManager &pipelineManager,
+                                           VkGraphicsPipelineState state)
+        : mPipelineManager(pipelineManager),
+          mState(std::move(state)) {
+}
+
+VkPipelineManager::Handle VkShaderVariantCache::variant(const vector<uint32_t> &constants) {
+    ++mLookupCount;
+
+    auto key = hashCombine(kHashSeed, constants);
+    auto &shard = mShards[key % kShardCount];
+
+    lock_guard<mutex> lock(shard.mutex);
+
+    // 해시가 같아도 실제 값이 다를 수 있으므로 값까지 비교한다.
+    auto [first, last] = shard.variants.equal_range(key);
+    for (auto iter = first; iter != last; ++iter) {
+        if (iter->second.constants == constants) {
+            ++mHitCount;
+            return iter->second.handle;
+        }
+    }
+
+    // ================================================================================
+    // 새로운 변형 파이프라인 요청
+    // ================================================================================
+    auto state = mState;
+    state.specializationMapEntries.resize(constants.size());
+    for (uint32_t i = 0; i != constants.size(); ++i) {
+        state.specializationMapEntries[i] = {
+            .constantID = i,
+            .offset = static_cast<uint32_t>(i * sizeof(uint32_t)),
+            .size = sizeof(uint32_t)
+        };
+    }
+    state.specializationData.resize(constants.size() * sizeof(uint32_t));
+    memcpy(state.specializationData.data(), constants.data(), state.specializationData.size());
+
+    auto handle = mPipelineManager.request(std::move(state));
+    shard.variants.emplace(key, Variant{constants, handle});
+
+    return handle;
+}
+
+void VkShaderVariantCache::report() const {
+    aout << "Shader Variant Cache Information ↓" << endl;
+    aout << setw(16) << left << " - Variants: " << mLookupCount - mHitCount << endl;
+    aout << setw(16) << left << " - Lookups: " << mLookupCount << endl;
+    if (mLookupCount) {
+        aout << setw(16) << left << " - Hit Rate: " << fixed << setprecision(1)
+             << 100.0 * mHitCount / mLookupCount << " %" << defaultfloat << endl;
+    }
+}
@@ -0,0 +1,74 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKSHADERVARIANTCACHE_H
+#define PRACTICE_VULKAN_VKSHADERVARIANTCACHE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "VkPipelineManager.h"
+
+/*!
+ * Pipeline variants of one VkGraphicsPipelineState that differ only in specialization constant
+ * values.
+ *
+ * Every constant is a 32-bit value and constant i maps to constant_id i. Variants are keyed by
+ * a hash of the values and spread over sharded maps so that lookups from several threads rarely
+ * contend. A miss requests the pipeline from the VkPipelineManager, so variant() never blocks
+ * on compilation.
+ */
+class VkShaderVariantCache {
+public:
+    VkShaderVariantCache(VkPipelineManager &pipelineManager, VkGraphicsPipelineState state);
+
+    VkShaderVariantCache(const VkShaderVariantCache &) = delete;
+    VkShaderVariantCache &operator=(const VkShaderVariantCache &) = delete;
+
+    VkPipelineManager::Handle variant(const std::vector<uint32_t> &constants);
+    void report() const;
+
+private:
+    static constexpr uint32_t kShardCount = 16;
+
+    struct Variant {
+        std::vector<uint32_t> constants;
+        VkPipelineManager::Handle handle;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_multimap<uint64_t, Variant> variants;
+    };
+
+    VkPipelineManager &mPipelineManager;
+    VkGraphicsPipelineState mState;
+    std::array<Shard, kShardCount> mShards;
+    std::atomic<uint64_t> mLookupCount = 0;
+    std::atomic<uint64_t> mHitCount = 0;
+};
+
+#endif //PRACTICE_VULKAN_VKSHADERVARIANTCACHE_H
@@ -0,0 +1,81 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "VkShaders.h"
+
+namespace {
+
+const uint32_t kTriangleVertexShaderCode[] = {
+#include "shaders/triangle.vert.inc"
+};
+
+const uint32_t kTriangleUniformVertexShaderCode[] = {
+#include "shaders/triangle_uniform.vert.inc"
+};
+
+const uint32_t kTriangleFragmentShaderCode[] = {
+#include "shaders/triangle.frag.inc"
+};
+
+const uint32_t kTriangleBindlessFragmentShaderCode[] = {
+#include "shaders/triangle_bindless.frag.inc"
+};
+
+const uint32_t kFallbackFragmentShaderCode[] = {
+#include "shaders/fallback.frag.inc"
+};
+
+const uint32_t kCullComputeShaderCode[] = {
+#include "shaders/cull.comp.inc"
+};
+
+}
+
+const VkShaderCode kTriangleVertexShader{
+    kTriangleVertexShaderCode,
+    sizeof(kTriangleVertexShaderCode)
+};
+
+const VkShaderCode kTriangleUniformVertexShader{
+    kTriangleUniformVertexShaderCode,
+    sizeof(kTriangleUniformVertexShaderCode)
+};
+
+const VkShaderCode kTriangleFragmentShader{
+    kTriangleFragmentShaderCode,
+    sizeof(kTriangleFragmentShaderCode)
+};
+
+const VkShaderCode kTriangleBindlessFragmentShader{
+    kTriangleBindlessFragmentShaderCode,
+    sizeof(kTriangleBindlessFragmentShaderCode)
+};
+
+const VkShaderCode kFallbackFragmentShader{
+    kFallbackFragmentShaderCode,
+    sizeof(kFallbackFragmentShaderCode)
+};
+
+const VkShaderCode kCullComputeShader{
+    kCullComputeShaderCode,
+    sizeof(kCullComputeShaderCode)
+};
\ No newline at end of file
@@ -0,0 +1,44 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKSHADERS_H
+#define PRACTICE_VULKAN_VKSHADERS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * SPIR-V compiled from the shaders directory at build time and embedded into the library.
+ */
+struct VkShaderCode {
+    const uint32_t *code;
+    size_t size;
+};
+
+extern const VkShaderCode kTriangleVertexShader;
+extern const VkShaderCode kTriangleUniformVertexShader;
+extern const VkShaderCode kTriangleFragmentShader;
+extern const VkShaderCode kTriangleBindlessFragmentShader;
+extern const VkShaderCode kFallbackFragmentShader;
+extern const VkShaderCode kCullComputeShader;
+
+#endif //PRACTICE_VULKAN_VKSHADERS_H
@@ -0,0 +1,143 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cassert>
+#include <cstring>
+
+#include "VkTexture.h"
+#include "VkUtil.h"
+
+using namespace std;
+
+VkTexture::VkTexture(VkHostAllocator &hostAllocator,
+                     VkMemoryBudget &memoryBudget,
+                     VkDevice device,
+                     VkUploader &uploader,
+                     VkFormat format,
+                     VkExtent2D extent,
+                     const void *pixels,
+                     VkDeviceSize pixelsSize)
+        : mHostAllocator(hostAllocator),
+          mMemoryBudget(memoryBudget),
+          mDevice(device) {
+    // ================================================================================
+    // 1. VkImage 생성
+    // ================================================================================
+    VkImageCreateInfo imageCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .imageType = VK_IMAGE_TYPE_2D,
+        .format = format,
+        .extent = {extent.width, extent.height, 1},
+        .mipLevels = 1,
+        .arrayLayers = 1,
+        .samples = VK_SAMPLE_COUNT_1_BIT,
+        .tiling = VK_IMAGE_TILING_OPTIMAL,
+        .usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+    };
+
+    VK_CHECK_ERROR(vkCreateImage(mDevice,
+                                 &imageCreateInfo,
+                                 mHostAllocator.callbacks(VK_OBJECT_TYPE_IMAGE),
+                                 &mImage));
+
+    // ================================================================================
+    // 2. VkDeviceMemory 할당
+    // ================================================================================
+    VkMemoryRequirements memoryRequirements;
+    vkGetImageMemoryRequirements(mDevice, mImage, &memoryRequirements);
+
+    mMemoryTypeIndex = vkFindMemoryTypeIndex(mMemoryBudget.memoryProperties(),
+                                             memoryRequirements.memoryTypeBits,
+                                             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    assert(mMemoryTypeIndex != VK_MAX_MEMORY_TYPES);
+
+    VkMemoryAllocateInfo memoryAllocateInfo{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .allocationSize = memoryRequirements.size,
+        .memoryTypeIndex = mMemoryTypeIndex
+    };
+
+    VK_CHECK_ERROR(vkAllocateMemory(mDevice,
+                                    &memoryAllocateInfo,
+                                    mHostAllocator.callbacks(VK_OBJECT_TYPE_DEVICE_MEMORY),
+                                    &mMemory));
+    VK_CHECK_ERROR(vkBindImageMemory(mDevice, mImage, mMemory, 0));
+
+    mMemorySize = memoryAllocateInfo.allocationSize;
+    mMemoryBudget.onAllocate(mMemoryTypeIndex, mMemorySize);
+
+    // ================================================================================
+    // 3. VkImageView 생성
+    // ================================================================================
+    VkImageViewCreateInfo imageViewCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+        .image = mImage,
+        .viewType = VK_IMAGE_VIEW_TYPE_2D,
+        .format = format,
+        .subresourceRange = {
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .baseMipLevel = 0,
+            .levelCount = 1,
+            .baseArrayLayer = 0,
+            .layerCount = 1
+        }
+    };
+
+    VK_CHECK_ERROR(vkCreateImageView(mDevice,
+                                     &imageViewCreateInfo,
+                                     mHostAllocator.callbacks(VK_OBJECT_TYPE_IMAGE_VIEW),
+                                     &mImageView));
+
+    // ================================================================================
+    // 4. 픽셀 업로드
+    // ================================================================================
+    VkUploader::Allocation allocation;
+    auto reserved = uploader.reserve(pixelsSize, 16, &allocation);
+    assert(reserved);
+    memcpy(allocation.data, pixels, pixelsSize);
+
+    VkBufferImageCopy region{
+        .imageSubresource = {
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .mipLevel = 0,
+            .baseArrayLayer = 0,
+            .layerCount = 1
+        },
+        .imageExtent = {extent.width, extent.height, 1}
+    };
+
+    mUploadTicket = uploader.copyImage(allocation,
+                                       mImage,
+                                       region,
+                                       VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                       VK_ACCESS_SHADER_READ_BIT,
+                                       VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+}
+
+VkTexture::~VkTexture() {
+    vkDestroyImageView(mDevice, mImageView, mHostAllocator.callbacks(VK_OBJECT_TYPE_IMAGE_VIEW));
+    vkFreeMemory(mDevice, mMemory, mHostAllocator.callbacks(VK_OBJECT_TYPE_DEVICE_MEMORY));
+    mMemoryBudget.onFree(mMemoryTypeIndex, mMemorySize);
+    vkDestroyImage(mDevice, mImage, mHostAllocator.callbacks(VK_OBJECT_TYPE_IMAGE));
+}
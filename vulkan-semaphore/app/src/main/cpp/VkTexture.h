@@ -0,0 +1,70 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKTEXTURE_H
+#define PRACTICE_VULKAN_VKTEXTURE_H
+
+#include <cstdint>
+#include <vulkan/vulkan.h>
+
+#include "VkHostAllocator.h"
+#include "VkMemoryBudget.h"
+#include "VkUploader.h"
+
+/*!
+ * Sampled 2D image whose pixels are copied through the VkUploader staging ring.
+ *
+ * The image ends up in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL once the upload ticket
+ * completes, so it must not be sampled before the renderer has waited on that submission.
+ */
+class VkTexture {
+public:
+    VkTexture(VkHostAllocator &hostAllocator,
+              VkMemoryBudget &memoryBudget,
+              VkDevice device,
+              VkUploader &uploader,
+              VkFormat format,
+              VkExtent2D extent,
+              const void *pixels,
+              VkDeviceSize pixelsSize);
+    ~VkTexture();
+
+    VkTexture(const VkTexture &) = delete;
+    VkTexture &operator=(const VkTexture &) = delete;
+
+    VkImage image() const { return mImage; }
+    VkImageView imageView() const { return mImageView; }
+    uint64_t uploadTicket() const { return mUploadTicket; }
+
+private:
+    VkHostAllocator &mHostAllocator;
+    VkMemoryBudget &mMemoryBudget;
+    VkDevice mDevice;
+    VkImage mImage;
+    VkDeviceMemory mMemory;
+    uint32_t mMemoryTypeIndex;
+    VkDeviceSize mMemorySize;
+    VkImageView mImageView;
+    uint64_t mUploadTicket = 0;
+};
+
+#endif //PRACTICE_VULKAN_VKTEXTURE_H
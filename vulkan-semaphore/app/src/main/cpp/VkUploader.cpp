@@ -0,0 +1,467 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "VkUploader.h"
+#include "VkUtil.h"
+#include "AndroidOut.h"
+
+using namespace std;
+
+VkUploader::VkUploader(VkHostAllocator &hostAllocator,
+                       VkMemoryBudget &memoryBudget,
+                       VkDevice device,
+                       uint32_t queueFamilyIndex,
+                       VkQueue queue,
+                       uint32_t dstQueueFamilyIndex,
+                       VkDeviceSize capacity)
+        : mHostAllocator(hostAllocator),
+          mDevice(device),
+          mQueue(queue),
+          mQueueFamilyIndex(queueFamilyIndex),
+          mDstQueueFamilyIndex(dstQueueFamilyIndex),
+          mCapacity(capacity) {
+    // ================================================================================
+    // 1. Staging VkBuffer 생성
+    // ================================================================================
+    mStagingBuffer = make_unique<VkDeviceBuffer>(mHostAllocator,
+                                                 memoryBudget,
+                                                 mDevice,
+                                                 mCapacity,
+                                                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                 VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    mMappedData = static_cast<uint8_t *>(mStagingBuffer->mappedData());
+
+    // ================================================================================
+    // 2. 전송용 VkCommandPool 생성 및 VkCommandBuffer 할당
+    // ================================================================================
+    VkCommandPoolCreateInfo commandPoolCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+        .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT |
+                 VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+        .queueFamilyIndex = mQueueFamilyIndex
+    };
+
+    VK_CHECK_ERROR(vkCreateCommandPool(mDevice,
+                                       &commandPoolCreateInfo,
+                                       mHostAllocator.callbacks(VK_OBJECT_TYPE_COMMAND_POOL),
+                                       &mCommandPool));
+
+    array<VkCommandBuffer, kMaxBatchCount> commandBuffers;
+    VkCommandBufferAllocateInfo commandBufferAllocateInfo{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .commandPool = mCommandPool,
+        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        .commandBufferCount = kMaxBatchCount
+    };
+
+    VK_CHECK_ERROR(vkAllocateCommandBuffers(mDevice, &commandBufferAllocateInfo,
+                                            commandBuffers.data()));
+
+    // ================================================================================
+    // 3. 배치별 VkFence, VkSemaphore 생성
+    // ================================================================================
+    VkFenceCreateInfo fenceCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO
+    };
+
+    VkSemaphoreCreateInfo semaphoreCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO
+    };
+
+    for (auto i = 0; i != kMaxBatchCount; ++i) {
+        auto &batch = mBatches[i];
+        batch.commandBuffer = commandBuffers[i];
+        VK_CHECK_ERROR(vkCreateFence(mDevice,
+                                     &fenceCreateInfo,
+                                     mHostAllocator.callbacks(VK_OBJECT_TYPE_FENCE),
+                                     &batch.fence));
+        VK_CHECK_ERROR(vkCreateSemaphore(mDevice,
+                                         &semaphoreCreateInfo,
+                                         mHostAllocator.callbacks(VK_OBJECT_TYPE_SEMAPHORE),
+                                         &batch.semaphore));
+        batch.releaseSize = 0;
+        batch.serial = 0;
+        batch.pending = false;
+    }
+}
+
+VkUploader::~VkUploader() {
+    // 복사나 release() 없이 남은 예약이 있으면 링이 그 지점에서 더 이상 회수되지 않는다.
+    assert(all_of(mReservations.begin(), mReservations.end(), [](const Reservation &reservation) {
+        return reservation.enqueued;
+    }));
+
+    for (auto &batch: mBatches) {
+        if (batch.pending) {
+            VK_CHECK_ERROR(vkWaitForFences(mDevice, 1, &batch.fence, VK_TRUE, UINT64_MAX));
+        }
+        vkDestroySemaphore(mDevice,
+                           batch.semaphore,
+                           mHostAllocator.callbacks(VK_OBJECT_TYPE_SEMAPHORE));
+        vkDestroyFence(mDevice, batch.fence, mHostAllocator.callbacks(VK_OBJECT_TYPE_FENCE));
+        vkFreeCommandBuffers(mDevice, mCommandPool, 1, &batch.commandBuffer);
+    }
+    vkDestroyCommandPool(mDevice,
+                         mCommandPool,
+                         mHostAllocator.callbacks(VK_OBJECT_TYPE_COMMAND_POOL));
+}
+
+bool VkUploader::reserve(VkDeviceSize size, VkDeviceSize alignment, Allocation *allocation) {
+    assert(allocation);
+    assert(alignment && !(alignment & (alignment - 1)));
+
+    lock_guard<mutex> lock(mMutex);
+    reclaim();
+
+    // 링의 끝에 공간이 부족하면 남은 공간을 버리고 처음으로 돌아간다.
+    auto offset = (mHead + alignment - 1) & ~(alignment - 1);
+    auto padding = offset - mHead;
+    if (offset + size > mCapacity) {
+        padding = mCapacity - mHead;
+        offset = 0;
+    }
+
+    auto consumedSize = padding + size;
+    if (mUsedSize + consumedSize > mCapacity) {
+        return false;
+    }
+
+    mHead = (offset + size) % mCapacity;
+    mUsedSize += consumedSize;
+    mReservations.push_back({consumedSize, false});
+
+    *allocation = {
+        .data = mMappedData + offset,
+        .offset = offset,
+        .size = size,
+        .sequence = mFrontSequence + mReservations.size() - 1
+    };
+
+    return true;
+}
+
+void VkUploader::release(const Allocation &allocation) {
+    lock_guard<mutex> lock(mMutex);
+    markEnqueued(allocation.sequence);
+}
+
+uint64_t VkUploader::copyBuffer(const Allocation &allocation,
+                                VkBuffer dstBuffer,
+                                VkDeviceSize dstOffset,
+                                VkAccessFlags dstAccessMask,
+                                VkPipelineStageFlags dstStageMask) {
+    assert(dstStageMask);
+
+    lock_guard<mutex> lock(mMutex);
+    markEnqueued(allocation.sequence);
+
+    mBufferCopies.push_back({
+        .dstBuffer = dstBuffer,
+        .region = {
+            .srcOffset = allocation.offset,
+            .dstOffset = dstOffset,
+            .size = allocation.size
+        },
+        .dstAccessMask = dstAccessMask,
+        .dstStageMask = dstStageMask
+    });
+
+    return mSerial;
+}
+
+uint64_t VkUploader::copyImage(const Allocation &allocation,
+                               VkImage dstImage,
+                               const VkBufferImageCopy &region,
+                               VkImageLayout finalLayout,
+                               VkAccessFlags dstAccessMask,
+                               VkPipelineStageFlags dstStageMask) {
+    assert(dstStageMask);
+
+    lock_guard<mutex> lock(mMutex);
+    markEnqueued(allocation.sequence);
+
+    mImageCopies.push_back({
+        .dstImage = dstImage,
+        .region = region,
+        .finalLayout = finalLayout,
+        .dstAccessMask = dstAccessMask,
+        .dstStageMask = dstStageMask
+    });
+    mImageCopies.back().region.bufferOffset += allocation.offset;
+
+    return mSerial;
+}
+
+uint64_t VkUploader::uploadBuffer(const void *data,
+                                  VkDeviceSize size,
+                                  VkBuffer dstBuffer,
+                                  VkDeviceSize dstOffset,
+                                  VkAccessFlags dstAccessMask,
+                                  VkPipelineStageFlags dstStageMask) {
+    Allocation allocation;
+    if (!reserve(size, 4, &allocation)) {
+        return 0;
+    }
+
+    memcpy(allocation.data, data, size);
+
+    return copyBuffer(allocation, dstBuffer, dstOffset, dstAccessMask, dstStageMask);
+}
+
+bool VkUploader::submit(Submission *submission) {
+    assert(submission);
+
+    lock_guard<mutex> lock(mMutex);
+    reclaim();
+
+    if (mBufferCopies.empty() && mImageCopies.empty()) {
+        return false;
+    }
+
+    auto &batch = mBatches[mBatchIndex];
+    if (batch.pending) {
+        VK_CHECK_ERROR(vkWaitForFences(mDevice, 1, &batch.fence, VK_TRUE, UINT64_MAX));
+        reclaim();
+    }
+    assert(!batch.pending);
+
+    mRecordingBufferCopies.swap(mBufferCopies);
+    mRecordingImageCopies.swap(mImageCopies);
+
+    // 복사가 기록된 예약만 링에서 순서대로 해제할 수 있다.
+    batch.releaseSize = 0;
+    while (!mReservations.empty() && mReservations.front().enqueued) {
+        batch.releaseSize += mReservations.front().consumedSize;
+        mReservations.pop_front();
+        ++mFrontSequence;
+    }
+    batch.serial = mSerial++;
+
+    auto transferOwnership = mQueueFamilyIndex != mDstQueueFamilyIndex;
+    auto srcQueueFamilyIndex = transferOwnership ? mQueueFamilyIndex : VK_QUEUE_FAMILY_IGNORED;
+    auto dstQueueFamilyIndex = transferOwnership ? mDstQueueFamilyIndex : VK_QUEUE_FAMILY_IGNORED;
+
+    submission->dstStageMask = 0;
+    submission->bufferMemoryBarriers.clear();
+    submission->imageMemoryBarriers.clear();
+
+    // ================================================================================
+    // 1. VkCommandBuffer 기록 시작
+    // ================================================================================
+    vkResetCommandBuffer(batch.commandBuffer, 0);
+
+    VkCommandBufferBeginInfo commandBufferBeginInfo{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+    };
+
+    VK_CHECK_ERROR(vkBeginCommandBuffer(batch.commandBuffer, &commandBufferBeginInfo));
+
+    // ================================================================================
+    // 2. 복사를 위한 VkImageLayout 변환
+    // ================================================================================
+    vector<VkImageMemoryBarrier> imageMemoryBarriers;
+    imageMemoryBarriers.reserve(mRecordingImageCopies.size());
+    for (const auto &copy: mRecordingImageCopies) {
+        imageMemoryBarriers.push_back({
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_NONE,
+            .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = copy.dstImage,
+            .subresourceRange = {
+                .aspectMask = copy.region.imageSubresource.aspectMask,
+                .baseMipLevel = copy.region.imageSubresource.mipLevel,
+                .levelCount = 1,
+                .baseArrayLayer = copy.region.imageSubresource.baseArrayLayer,
+                .layerCount = copy.region.imageSubresource.layerCount
+            }
+        });
+    }
+
+    if (!imageMemoryBarriers.empty()) {
+        vkCmdPipelineBarrier(batch.commandBuffer,
+                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             static_cast<uint32_t>(imageMemoryBarriers.size()),
+                             imageMemoryBarriers.data());
+    }
+
+    // ================================================================================
+    // 3. 복사 명령 기록
+    // ================================================================================
+    for (const auto &copy: mRecordingBufferCopies) {
+        vkCmdCopyBuffer(batch.commandBuffer,
+                        mStagingBuffer->buffer(),
+                        copy.dstBuffer,
+                        1,
+                        &copy.region);
+    }
+
+    for (const auto &copy: mRecordingImageCopies) {
+        vkCmdCopyBufferToImage(batch.commandBuffer,
+                               mStagingBuffer->buffer(),
+                               copy.dstImage,
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               1,
+                               &copy.region);
+    }
+
+    // ================================================================================
+    // 4. 소유권 이전(Release) 및 최종 VkImageLayout 변환
+    // ================================================================================
+    vector<VkBufferMemoryBarrier> bufferMemoryBarriers;
+    if (transferOwnership) {
+        bufferMemoryBarriers.reserve(mRecordingBufferCopies.size());
+        for (const auto &copy: mRecordingBufferCopies) {
+            VkBufferMemoryBarrier bufferMemoryBarrier{
+                .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+                .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_NONE,
+                .srcQueueFamilyIndex = srcQueueFamilyIndex,
+                .dstQueueFamilyIndex = dstQueueFamilyIndex,
+                .buffer = copy.dstBuffer,
+                .offset = copy.region.dstOffset,
+                .size = copy.region.size
+            };
+            bufferMemoryBarriers.push_back(bufferMemoryBarrier);
+
+            bufferMemoryBarrier.srcAccessMask = VK_ACCESS_NONE;
+            bufferMemoryBarrier.dstAccessMask = copy.dstAccessMask;
+            submission->bufferMemoryBarriers.push_back(bufferMemoryBarrier);
+        }
+    }
+
+    for (auto i = 0; i != mRecordingImageCopies.size(); ++i) {
+        const auto &copy = mRecordingImageCopies[i];
+        auto &imageMemoryBarrier = imageMemoryBarriers[i];
+        imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        imageMemoryBarrier.dstAccessMask = VK_ACCESS_NONE;
+        imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        imageMemoryBarrier.newLayout = copy.finalLayout;
+        imageMemoryBarrier.srcQueueFamilyIndex = srcQueueFamilyIndex;
+        imageMemoryBarrier.dstQueueFamilyIndex = dstQueueFamilyIndex;
+
+        if (transferOwnership) {
+            auto acquireImageMemoryBarrier = imageMemoryBarrier;
+            acquireImageMemoryBarrier.srcAccessMask = VK_ACCESS_NONE;
+            acquireImageMemoryBarrier.dstAccessMask = copy.dstAccessMask;
+            submission->imageMemoryBarriers.push_back(acquireImageMemoryBarrier);
+        }
+    }
+
+    if (!bufferMemoryBarriers.empty() || !imageMemoryBarriers.empty()) {
+        vkCmdPipelineBarrier(batch.commandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             static_cast<uint32_t>(bufferMemoryBarriers.size()),
+                             bufferMemoryBarriers.data(),
+                             static_cast<uint32_t>(imageMemoryBarriers.size()),
+                             imageMemoryBarriers.data());
+    }
+
+    for (const auto &copy: mRecordingBufferCopies) {
+        submission->dstStageMask |= copy.dstStageMask;
+    }
+
+    for (const auto &copy: mRecordingImageCopies) {
+        submission->dstStageMask |= copy.dstStageMask;
+    }
+
+    // 0은 유효한 대기 단계가 아니므로 대상 단계를 모르면 모든 단계에서 기다린다.
+    if (!submission->dstStageMask) {
+        submission->dstStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    }
+
+    // ================================================================================
+    // 5. VkCommandBuffer 기록 종료 및 제출
+    // ================================================================================
+    VK_CHECK_ERROR(vkEndCommandBuffer(batch.commandBuffer));
+
+    VkSubmitInfo submitInfo{
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &batch.commandBuffer,
+        .signalSemaphoreCount = 1,
+        .pSignalSemaphores = &batch.semaphore
+    };
+
+    VK_CHECK_ERROR(vkResetFences(mDevice, 1, &batch.fence));
+    VK_CHECK_ERROR(vkQueueSubmit(mQueue, 1, &submitInfo, batch.fence));
+
+    batch.pending = true;
+    mBatchIndex = (mBatchIndex + 1) % kMaxBatchCount;
+    mRecordingBufferCopies.clear();
+    mRecordingImageCopies.clear();
+
+    submission->semaphore = batch.semaphore;
+
+    return true;
+}
+
+bool VkUploader::isComplete(uint64_t ticket) const {
+    return ticket <= mCompletedSerial;
+}
+
+bool VkUploader::hasPendingCopies() {
+    lock_guard<mutex> lock(mMutex);
+    return !mBufferCopies.empty() || !mImageCopies.empty();
+}
+
+void VkUploader::markEnqueued(uint64_t sequence) {
+    assert(sequence >= mFrontSequence && sequence - mFrontSequence < mReservations.size());
+    mReservations[sequence - mFrontSequence].enqueued = true;
+}
+
+void VkUploader::reclaim() {
+    // 가장 오래된 배치부터 순서대로 완료 여부를 확인한다.
+    for (auto i = 0; i != kMaxBatchCount; ++i) {
+        auto &batch = mBatches[(mBatchIndex + i) % kMaxBatchCount];
+        if (!batch.pending) {
+            continue;
+        }
+
+        if (vkGetFenceStatus(mDevice, batch.fence) != VK_SUCCESS) {
+            break;
+        }
+
+        mUsedSize -= batch.releaseSize;
+        mCompletedSerial = batch.serial;
+        batch.pending = false;
+    }
+}
@@ -0,0 +1,163 @@
+// MIT License
+//
+// Copyright (c) 2024 Daemyung Jang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PRACTICE_VULKAN_VKUPLOADER_H
+#define PRACTICE_VULKAN_VKUPLOADER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "VkDeviceBuffer.h"
+#include "VkHostAllocator.h"
+#include "VkMemoryBudget.h"
+
+/*!
+ * Staging ring buffer that batches buffer/image copies into one transfer submission.
+ *
+ * Any thread may reserve() space, write into the mapped pointer and enqueue a copy. The render
+ * thread calls submit() once per frame, which records every enqueued copy into one command
+ * buffer and submits it to the transfer queue. Each copy returns a ticket that can be polled
+ * with isComplete().
+ *
+ * Space is reclaimed in reservation order, so every reserve() must be followed by exactly one
+ * copyBuffer(), copyImage() or release(). A reservation left open stops reclamation at its
+ * offset and eventually makes every reserve() fail. Released space is returned together with
+ * the next submitted batch.
+ */
+class VkUploader {
+public:
+    struct Allocation {
+        void *data;
+        VkDeviceSize offset;
+        VkDeviceSize size;
+        uint64_t sequence;
+    };
+
+    struct Submission {
+        VkSemaphore semaphore;
+        VkPipelineStageFlags dstStageMask;
+        std::vector<VkBufferMemoryBarrier> bufferMemoryBarriers;
+        std::vector<VkImageMemoryBarrier> imageMemoryBarriers;
+    };
+
+    VkUploader(VkHostAllocator &hostAllocator,
+               VkMemoryBudget &memoryBudget,
+               VkDevice device,
+               uint32_t queueFamilyIndex,
+               VkQueue queue,
+               uint32_t dstQueueFamilyIndex,
+               VkDeviceSize capacity);
+    ~VkUploader();
+
+    bool reserve(VkDeviceSize size, VkDeviceSize alignment, Allocation *allocation);
+    // 복사하지 않기로 한 예약을 닫는다.
+    void release(const Allocation &allocation);
+    uint64_t copyBuffer(const Allocation &allocation,
+                        VkBuffer dstBuffer,
+                        VkDeviceSize dstOffset,
+                        VkAccessFlags dstAccessMask,
+                        VkPipelineStageFlags dstStageMask);
+    uint64_t copyImage(const Allocation &allocation,
+                       VkImage dstImage,
+                       const VkBufferImageCopy &region,
+                       VkImageLayout finalLayout,
+                       VkAccessFlags dstAccessMask,
+                       VkPipelineStageFlags dstStageMask);
+    // 링에 공간이 없으면 0을 반환한다.
+    uint64_t uploadBuffer(const void *data,
+                          VkDeviceSize size,
+                          VkBuffer dstBuffer,
+                          VkDeviceSize dstOffset,
+                          VkAccessFlags dstAccessMask,
+                          VkPipelineStageFlags dstStageMask);
+    bool submit(Submission *submission);
+    bool isComplete(uint64_t ticket) const;
+    // 아직 submit()으로 기록되지 않은 복사가 있는지 반환한다.
+    bool hasPendingCopies();
+
+private:
+    static constexpr uint32_t kMaxBatchCount = 4;
+
+    struct Reservation {
+        VkDeviceSize consumedSize;
+        bool enqueued;
+    };
+
+    struct BufferCopy {
+        VkBuffer dstBuffer;
+        VkBufferCopy region;
+        VkAccessFlags dstAccessMask;
+        VkPipelineStageFlags dstStageMask;
+    };
+
+    struct ImageCopy {
+        VkImage dstImage;
+        VkBufferImageCopy region;
+        VkImageLayout finalLayout;
+        VkAccessFlags dstAccessMask;
+        VkPipelineStageFlags dstStageMask;
+    };
+
+    struct Batch {
+        VkCommandBuffer commandBuffer;
+        VkFence fence;
+        VkSemaphore semaphore;
+        VkDeviceSize releaseSize;
+        uint64_t serial;
+        bool pending;
+    };
+
+    void markEnqueued(uint64_t sequence);
+    void reclaim();
+
+    VkHostAllocator &mHostAllocator;
+    VkDevice mDevice;
+    VkQueue mQueue;
+    uint32_t mQueueFamilyIndex;
+    uint32_t mDstQueueFamilyIndex;
+    std::unique_ptr<VkDeviceBuffer> mStagingBuffer;
+    uint8_t *mMappedData;
+    VkCommandPool mCommandPool;
+    std::array<Batch, kMaxBatchCount> mBatches;
+    uint32_t mBatchIndex = 0;
+
+    std::mutex mMutex;
+    VkDeviceSize mCapacity;
+    VkDeviceSize mHead = 0;
+    VkDeviceSize mUsedSize = 0;
+    std::deque<Reservation> mReservations;
+    uint64_t mFrontSequence = 0;
+    std::vector<BufferCopy> mBufferCopies;
+    std::vector<ImageCopy> mImageCopies;
+    std::vector<BufferCopy> mRecordingBufferCopies;
+    std::vector<ImageCopy> mRecordingImageCopies;
+    uint64_t mSerial = 1;
+    std::atomic<uint64_t> mCompletedSerial = 0;
+};
+
+#endif //PRACTICE_VULKAN_VKUPLOADER_H
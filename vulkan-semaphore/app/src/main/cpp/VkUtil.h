@@ -23,8 +23,10 @@
 #ifndef PRACTICE_VULKAN_VKUTIL_H
 #define PRACTICE_VULKAN_VKUTIL_H
 
+#include <initializer_list>
 #include <string_view>
 #include <string>
+#include <type_traits>
 #include <vulkan/vulkan.h>
 
 #ifndef NDEBUG
@@ -142,4 +144,119 @@ inline std::string_view vkToString(VkPhysicalDeviceType physicalDeviceType) {
     }
 }
 
+inline std::string_view vkToString(VkSystemAllocationScope allocationScope) {
+    switch (allocationScope) {
+        case VK_SYSTEM_ALLOCATION_SCOPE_COMMAND:
+            return "Command";
+        case VK_SYSTEM_ALLOCATION_SCOPE_OBJECT:
+            return "Object";
+        case VK_SYSTEM_ALLOCATION_SCOPE_CACHE:
+            return "Cache";
+        case VK_SYSTEM_ALLOCATION_SCOPE_DEVICE:
+            return "Device";
+        case VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE:
+            return "Instance";
+        default:
+            return "Unknown";
+    }
+}
+
+inline std::string_view vkToString(VkObjectType objectType) {
+    switch (objectType) {
+        case VK_OBJECT_TYPE_INSTANCE:
+            return "Instance";
+        case VK_OBJECT_TYPE_PHYSICAL_DEVICE:
+            return "Physical Device";
+        case VK_OBJECT_TYPE_DEVICE:
+            return "Device";
+        case VK_OBJECT_TYPE_QUEUE:
+            return "Queue";
+        case VK_OBJECT_TYPE_SEMAPHORE:
+            return "Semaphore";
+        case VK_OBJECT_TYPE_COMMAND_BUFFER:
+            return "Command Buffer";
+        case VK_OBJECT_TYPE_FENCE:
+            return "Fence";
+        case VK_OBJECT_TYPE_DEVICE_MEMORY:
+            return "Device Memory";
+        case VK_OBJECT_TYPE_BUFFER:
+            return "Buffer";
+        case VK_OBJECT_TYPE_IMAGE:
+            return "Image";
+        case VK_OBJECT_TYPE_EVENT:
+            return "Event";
+        case VK_OBJECT_TYPE_QUERY_POOL:
+            return "Query Pool";
+        case VK_OBJECT_TYPE_BUFFER_VIEW:
+            return "Buffer View";
+        case VK_OBJECT_TYPE_IMAGE_VIEW:
+            return "Image View";
+        case VK_OBJECT_TYPE_SHADER_MODULE:
+            return "Shader Module";
+        case VK_OBJECT_TYPE_PIPELINE_CACHE:
+            return "Pipeline Cache";
+        case VK_OBJECT_TYPE_PIPELINE_LAYOUT:
+            return "Pipeline Layout";
+        case VK_OBJECT_TYPE_RENDER_PASS:
+            return "Render Pass";
+        case VK_OBJECT_TYPE_PIPELINE:
+            return "Pipeline";
+        case VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT:
+            return "Descriptor Set Layout";
+        case VK_OBJECT_TYPE_SAMPLER:
+            return "Sampler";
+        case VK_OBJECT_TYPE_DESCRIPTOR_POOL:
+            return "Descriptor Pool";
+        case VK_OBJECT_TYPE_DESCRIPTOR_SET:
+            return "Descriptor Set";
+        case VK_OBJECT_TYPE_FRAMEBUFFER:
+            return "Framebuffer";
+        case VK_OBJECT_TYPE_COMMAND_POOL:
+            return "Command Pool";
+        case VK_OBJECT_TYPE_SURFACE_KHR:
+            return "Surface";
+        case VK_OBJECT_TYPE_SWAPCHAIN_KHR:
+            return "Swapchain";
+        case VK_OBJECT_TYPE_SHADER_EXT:
+            return "Shader";
+        default:
+            return "Unknown";
+    }
+}
+
+template<typename T>
+inline void vkChain(void **ppNext, T *pStruct) {
+    pStruct->pNext = *ppNext;
+    *ppNext = pStruct;
+}
+
+template<typename T>
+inline T vkGetDeviceProc(VkDevice device, std::initializer_list<const char *> names) {
+    for (auto name: names) {
+        if (auto function = vkGetDeviceProcAddr(device, name)) {
+            return reinterpret_cast<T>(function);
+        }
+    }
+    return nullptr;
+}
+
+// Vulkan의 정렬 한도와 alignof는 모두 2의 거듭제곱이므로 나눗셈 대신 마스크로 올림한다.
+template<typename T>
+inline T alignUp(T value, std::type_identity_t<T> alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+inline uint32_t vkFindMemoryTypeIndex(const VkPhysicalDeviceMemoryProperties &memoryProperties,
+                                      uint32_t memoryTypeBits,
+                                      VkMemoryPropertyFlags memoryPropertyFlags) {
+    for (uint32_t i = 0; i != memoryProperties.memoryTypeCount; ++i) {
+        if ((memoryTypeBits & (0x1u << i)) &&
+            (memoryProperties.memoryTypes[i].propertyFlags & memoryPropertyFlags) ==
+            memoryPropertyFlags) {
+            return i;
+        }
+    }
+    return VK_MAX_MEMORY_TYPES;
+}
+
 #endif //PRACTICE_VULKAN_VKUTIL_H
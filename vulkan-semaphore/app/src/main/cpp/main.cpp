@@ -16,7 +16,17 @@ extern "C" {
 void handle_cmd(android_app *pApp, int32_t cmd) {
     switch (cmd) {
         case APP_CMD_INIT_WINDOW:
-            pApp->userData = new VkRenderer(pApp->window);
+            pApp->userData = new VkRenderer(pApp->window, pApp->activity->internalDataPath);
+            break;
+        case APP_CMD_LOST_FOCUS:
+            if (pApp->userData) {
+                static_cast<VkRenderer *>(pApp->userData)->pause();
+            }
+            break;
+        case APP_CMD_GAINED_FOCUS:
+            if (pApp->userData) {
+                static_cast<VkRenderer *>(pApp->userData)->resume();
+            }
             break;
         case APP_CMD_TERM_WINDOW:
             if (pApp->userData) {
@@ -60,8 +70,12 @@ void android_main(struct android_app *pApp) {
     int events;
     android_poll_source *pSource;
     do {
-        // Process all pending events before running game logic.
-        if (ALooper_pollAll(0, nullptr, &events, (void **) &pSource) >= 0) {
+        // Process all pending events before running game logic. When the renderer has nothing
+        // new to draw, block until the next event or animation step instead of spinning.
+        auto timeout = pApp->userData
+                       ? static_cast<VkRenderer *>(pApp->userData)->pollTimeout()
+                       : -1;
+        if (ALooper_pollAll(timeout, nullptr, &events, (void **) &pSource) >= 0) {
             if (pSource) {
                 pSource->process(pApp, pSource);
             }
@@ -0,0 +1,10 @@
+#version 450
+
+layout(location = 0) in vec3 inColor;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    // 실제 파이프라인이 준비될 때까지 사용하는 단색 셰이더.
+    outColor = vec4(0.5, 0.5, 0.5, 1.0);
+}
@@ -0,0 +1,21 @@
+#version 450
+
+// 0: 정점 색상, 1: 흑백, 2: 반전
+layout(constant_id = 0) const uint kColorMode = 0;
+
+layout(set = 0, binding = 0) uniform sampler2D uTexture;
+
+layout(location = 0) in vec3 inColor;
+layout(location = 1) in vec2 inTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    vec3 color = inColor * texture(uTexture, inTexCoord).rgb;
+    if (kColorMode == 1) {
+        color = vec3(dot(color, vec3(0.299, 0.587, 0.114)));
+    } else if (kColorMode == 2) {
+        color = vec3(1.0) - color;
+    }
+    outColor = vec4(color, 1.0);
+}
@@ -0,0 +1,25 @@
+#version 450
+
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec3 inColor;
+layout(location = 2) in vec3 inInstance;
+layout(location = 3) in uint inTextureIndex;
+// 매 프레임 CPU 애니메이션이 쓰는 [0, 1) 위상
+layout(location = 4) in float inPhase;
+
+layout(location = 0) out vec3 outColor;
+layout(location = 1) out vec2 outTexCoord;
+layout(location = 2) flat out uint outTextureIndex;
+
+// Draw마다 바뀌는 데이터. 크기가 허용하면 push constant로 전달된다.
+layout(push_constant) uniform DrawData {
+    vec4 tint;
+} uDrawData;
+
+void main() {
+    float scale = inInstance.z * (0.8 + 0.2 * sin(6.28318531 * inPhase));
+    gl_Position = vec4(inPosition * scale + inInstance.xy, 0.0, 1.0);
+    outColor = inColor * uDrawData.tint.rgb;
+    outTexCoord = inPosition + 0.5;
+    outTextureIndex = inTextureIndex;
+}
@@ -0,0 +1,24 @@
+#version 450
+
+// 0: 정점 색상, 1: 흑백, 2: 반전
+layout(constant_id = 0) const uint kColorMode = 0;
+
+// VkBindlessTable::kMaxTextureCount와 같아야 한다.
+layout(set = 0, binding = 0) uniform sampler2D uTextures[1024];
+
+layout(location = 0) in vec3 inColor;
+layout(location = 1) in vec2 inTexCoord;
+layout(location = 2) flat in uint inTextureIndex;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    // 인덱스는 draw 안에서 일정하므로 nonuniformEXT 없이 동적 인덱싱만 사용한다.
+    vec3 color = inColor * texture(uTextures[inTextureIndex], inTexCoord).rgb;
+    if (kColorMode == 1) {
+        color = vec3(dot(color, vec3(0.299, 0.587, 0.114)));
+    } else if (kColorMode == 2) {
+        color = vec3(1.0) - color;
+    }
+    outColor = vec4(color, 1.0);
+}